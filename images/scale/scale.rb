@@ -5,6 +5,9 @@ def log10(x)
 end
 
 
+# dbu_to_v() and vu_to_v() are mirrored in src/calculate_transfer_curve.py,
+# which reads V_MIN and V_MAX from here, keep them in sync.
+
 def _dbu_to_v(dbu)
   return 10**((dbu + 20 * log10(Math.sqrt(0.6))) / 20)
 end
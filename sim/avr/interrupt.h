@@ -0,0 +1,13 @@
+#ifndef SIM_AVR_INTERRUPT_H
+#define SIM_AVR_INTERRUPT_H
+
+#include <avr/io.h>
+
+/* Interrupt flag is kept, so twi_model.c knows when the handler could run.
+ * The handler is an ordinary function. */
+#define sei() (SREG |= _BV(SREG_I))
+#define cli() (SREG &= ~_BV(SREG_I))
+
+#define ISR(vector, ...) void vector(void)
+
+#endif /* SIM_AVR_INTERRUPT_H */
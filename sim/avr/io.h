@@ -0,0 +1,36 @@
+#ifndef SIM_AVR_IO_H
+#define SIM_AVR_IO_H
+
+#include <stdint.h>
+
+#define _BV(bit) (1 << (bit))
+
+/* Only the global interrupt flag is kept, see avr/interrupt.h */
+extern uint8_t SREG;
+#define SREG_I (7)
+
+/* TWI registers are modelled by twi_model.c, each access lets it catch up
+ * with what was written before */
+typedef enum twi_model_register_t_ {
+  TWI_MODEL_TWBR,
+  TWI_MODEL_TWCR,
+  TWI_MODEL_TWSR,
+  TWI_MODEL_TWDR
+} twi_model_register_t;
+
+volatile uint8_t *twi_model_register(twi_model_register_t reg);
+
+#define TWBR (*twi_model_register(TWI_MODEL_TWBR))
+#define TWCR (*twi_model_register(TWI_MODEL_TWCR))
+#define TWSR (*twi_model_register(TWI_MODEL_TWSR))
+#define TWDR (*twi_model_register(TWI_MODEL_TWDR))
+
+#define TWINT (7)
+#define TWEA (6)
+#define TWSTA (5)
+#define TWSTO (4)
+#define TWWC (3)
+#define TWEN (2)
+#define TWIE (0)
+
+#endif /* SIM_AVR_IO_H */
@@ -0,0 +1,23 @@
+#ifndef SIM_AVR_PGMSPACE_H
+#define SIM_AVR_PGMSPACE_H
+
+/* Program memory is ordinary memory on the host */
+
+#include <stdint.h>
+#include <string.h>
+
+#define PROGMEM
+
+/* With the TWI model, reading tables is what takes the CPU time, so the bus
+ * moves on with them */
+#ifdef SIM_TWI
+uint8_t twi_model_read_byte(const void *address);
+#define pgm_read_byte(address) twi_model_read_byte(address)
+#else
+#define pgm_read_byte(address) (*(const uint8_t *) (address))
+#endif
+#define pgm_read_word(address) (*(const uint16_t *) (address))
+#define pgm_read_ptr(address) (*(void * const *) (address))
+#define memcpy_P memcpy
+
+#endif /* SIM_AVR_PGMSPACE_H */
@@ -0,0 +1,15 @@
+#ifndef SIM_AVR_SLEEP_H
+#define SIM_AVR_SLEEP_H
+
+#define sleep_enable() do { } while (0)
+#define sleep_disable() do { } while (0)
+
+/* With the TWI model, the bus moves on until an interrupt wakes the CPU up */
+#ifdef SIM_TWI
+void twi_model_sleep(void);
+#define sleep_cpu() twi_model_sleep()
+#else
+#define sleep_cpu() do { } while (0)
+#endif
+
+#endif /* SIM_AVR_SLEEP_H */
@@ -0,0 +1,135 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "config.h"
+#include "images.h"
+#include "display.h"
+#include "progmem_image_sprite.h"
+#include "progmem_rle_image_sprite.h"
+#include "vu_meter.h"
+#include "ssd1306_model.h"
+#include "i2c_mock.h"
+#include "display_check.h"
+#include "needle_check.h"
+
+
+/* Host benchmark of the rendering pipeline. Sweeps the needle over every
+ * angle on both meters, like main.c would, and checks the display contents
+ * after each frame against all sprites composed from scratch. Needle tables
+ * are checked against the per-pixel renderer first.
+ */
+
+#if DISPLAY_TRANSPORT != DISPLAY_TRANSPORT_I2C
+#error "Only displays on I2C are modelled"
+#endif
+
+#define SWEEPS_N (4)
+
+
+#if BACKGROUND_COMPRESSED
+static progmem_rle_image_sprite_t BACKGROUND_SPRITE;
+#else
+static progmem_image_sprite_t BACKGROUND_SPRITE;
+#endif
+static vu_meter_t METERS[2]; /* L and R */
+static ssd1306_model_t DISPLAY_L;
+static ssd1306_model_t DISPLAY_R;
+
+
+static uint64_t
+now_ns(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t) ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+
+int
+main(void)
+{
+  needle_check();
+
+  ssd1306_model_init(&DISPLAY_L, DISPLAY_A_ADDRESS);
+  ssd1306_model_init(&DISPLAY_R, DISPLAY_B_ADDRESS);
+  i2c_mock_attach(&DISPLAY_L);
+  i2c_mock_attach(&DISPLAY_R);
+  i2c_init();
+
+#if BACKGROUND_COMPRESSED
+  progmem_rle_image_sprite_init(&BACKGROUND_SPRITE, BACKGROUND_RLE, 0, 0);
+#else
+  progmem_image_sprite_init(&BACKGROUND_SPRITE, BACKGROUND, 0, 0);
+#endif
+
+  vu_meter_init(&(METERS[0]), DISPLAY_A_ADDRESS, 0, &(BACKGROUND_SPRITE.sprite));
+  vu_meter_init(&(METERS[1]), DISPLAY_B_ADDRESS, 0, &(BACKGROUND_SPRITE.sprite));
+  vu_meter_redraw_all(METERS, 2);
+  i2c_wait();
+
+  display_check(&(METERS[0].display), &DISPLAY_L, 0);
+  display_check(&(METERS[1].display), &DISPLAY_R, 0);
+
+  i2c_mock_stats_t startup = i2c_mock_get_stats();
+  i2c_mock_reset_stats();
+  ssd1306_model_reset_stats(&DISPLAY_L);
+  ssd1306_model_reset_stats(&DISPLAY_R);
+#if TRAFFIC_STATS
+  ssd1306_reset_stats(&(METERS[0].device));
+  ssd1306_reset_stats(&(METERS[1].device));
+#endif
+
+  uint16_t frames_n = 0;
+  uint32_t updates_n = 0;
+  uint64_t render_ns = 0;
+
+  /* Up and down across the whole range, R meter going the other way */
+  for (uint8_t sweep = 0; sweep < SWEEPS_N; ++sweep) {
+    for (uint16_t step = 0; step < 2 * 256; ++step) {
+      uint8_t angle = (step < 256) ? step : 511 - step;
+
+      vu_meter_show_peak(&(METERS[0]), angle > 192);
+      vu_meter_show_peak(&(METERS[1]), 255 - angle > 192);
+
+      uint64_t start = now_ns();
+      updates_n += vu_meter_update(&(METERS[0]), angle);
+      updates_n += vu_meter_update(&(METERS[1]), 255 - angle);
+      render_ns += now_ns() - start;
+
+      ++frames_n;
+      display_check(&(METERS[0].display), &DISPLAY_L, frames_n);
+      display_check(&(METERS[1].display), &DISPLAY_R, frames_n);
+    }
+  }
+
+  i2c_mock_stats_t stats = i2c_mock_get_stats();
+  uint32_t cursor_moves = DISPLAY_L.cursor_moves + DISPLAY_R.cursor_moves;
+  uint32_t data_bytes = DISPLAY_L.data_bytes + DISPLAY_R.data_bytes;
+
+  /* Frame updates both meters */
+  printf("startup:           %lu bytes in %lu transactions, %.0f us at %ld Hz\n",
+    (unsigned long) startup.bytes, (unsigned long) startup.transactions,
+    (double) startup.bytes * 9 * 1000000 / I2C_CLOCK, I2C_CLOCK);
+  printf("frames:            %u (%u meter updates, %u skipped)\n", frames_n, updates_n, 2 * frames_n - updates_n);
+  printf("bytes/frame:       %.1f (%.1f data)\n", (double) stats.bytes / frames_n, (double) data_bytes / frames_n);
+  printf("starts/frame:      %.2f\n", (double) stats.starts / frames_n);
+  printf("cursor moves/frame: %.2f\n", (double) cursor_moves / frames_n);
+  printf("render ns/frame:   %.0f\n", (double) render_ns / frames_n);
+  printf("bus time/frame:    %.0f us at %ld Hz\n", (double) stats.bytes * 9 * 1000000 / I2C_CLOCK / frames_n, I2C_CLOCK);
+
+#if TRAFFIC_STATS
+  ssd1306_stats_t *l = &(METERS[0].device.stats);
+  ssd1306_stats_t *r = &(METERS[1].device.stats);
+
+  printf("per frame, as counted by ssd1306.c:\n");
+  printf("  starts:          %.2f\n", (double) (l->starts + r->starts) / frames_n);
+  printf("  address bytes:   %.2f\n", (double) (l->address_bytes + r->address_bytes) / frames_n);
+  printf("  control bytes:   %.2f\n", (double) (l->control_bytes + r->control_bytes) / frames_n);
+  printf("  cursor moves:    %.2f (%.1f bytes)\n",
+    (double) (l->cursor_moves + r->cursor_moves) / frames_n,
+    (double) (l->cursor_bytes + r->cursor_bytes) / frames_n);
+  printf("  payload bytes:   %.1f\n", (double) (l->payload_bytes + r->payload_bytes) / frames_n);
+#endif
+
+  return 0;
+}
@@ -0,0 +1,157 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <avr/interrupt.h>
+#include "config.h"
+#include "images.h"
+#include "display.h"
+#include "i2c.h"
+#include "progmem_image_sprite.h"
+#include "progmem_rle_image_sprite.h"
+#include "vu_meter.h"
+#include "ssd1306_model.h"
+#include "twi_model.h"
+#include "display_check.h"
+
+
+/* Rendering pipeline on top of the real I2C queue, with TWI peripheral, mux
+ * and displays modelled, see twi_model.h. All VU_METERS are updated each
+ * frame like main.c does, at a few speeds of the bus relative to the CPU, and
+ * display contents are checked after every few frames, while the next ones
+ * are in flight, then once the bus is idle.
+ */
+
+#if DISPLAY_TRANSPORT != DISPLAY_TRANSPORT_I2C
+#error "Only displays on I2C are modelled"
+#endif
+
+#if !TRAFFIC_STATS
+#error "Build with BENCH=1, queue statistics are reported"
+#endif
+
+#define SWEEPS_N (2)
+#define JITTER_FRAMES_N (1024)
+#define CHECK_PERIOD (4)
+
+#define METER_ADDRESS(address, channel, source) address,
+#define METER_CHANNEL(address, channel, source) channel,
+
+
+#if BACKGROUND_COMPRESSED
+static progmem_rle_image_sprite_t BACKGROUND_SPRITE;
+#else
+static progmem_image_sprite_t BACKGROUND_SPRITE;
+#endif
+static vu_meter_t METERS[VU_METERS_N];
+static uint8_t METER_CONFIG_INDICES[VU_METERS_N];
+
+static const uint8_t METER_ADDRESSES[VU_METERS_N] = { VU_METERS(METER_ADDRESS) };
+static const uint8_t METER_CHANNELS[VU_METERS_N] = { VU_METERS(METER_CHANNEL) };
+static ssd1306_model_t DISPLAYS[VU_METERS_N]; /* by config index */
+
+/* Bus steps every that many program memory reads, 0 only while the CPU sleeps */
+static const uint8_t SPEEDS[] = {0, 3, 7};
+
+
+static void
+check_all(uint16_t frame)
+{
+  for (uint8_t i = 0; i < VU_METERS_N; ++i) {
+    display_check(&(METERS[i].display), &(DISPLAYS[METER_CONFIG_INDICES[i]]), frame);
+  }
+}
+
+
+static uint8_t
+meter_angle(uint8_t config_index, uint8_t angle)
+{
+  return (config_index & 1) ? 255 - angle : angle;
+}
+
+
+static void
+run(uint8_t reads_per_step)
+{
+  twi_model_init(reads_per_step);
+
+  for (uint8_t i = 0; i < VU_METERS_N; ++i) {
+    ssd1306_model_init(&(DISPLAYS[i]), METER_ADDRESSES[i]);
+    twi_model_attach(&(DISPLAYS[i]), METER_CHANNELS[i]);
+  }
+
+  i2c_init();
+  sei();
+
+#if BACKGROUND_COMPRESSED
+  progmem_rle_image_sprite_init(&BACKGROUND_SPRITE, BACKGROUND_RLE, 0, 0);
+#else
+  progmem_image_sprite_init(&BACKGROUND_SPRITE, BACKGROUND, 0, 0);
+#endif
+
+  vu_meter_init_all(METERS, METER_CONFIG_INDICES, &(BACKGROUND_SPRITE.sprite));
+  vu_meter_redraw_all(METERS, VU_METERS_N);
+  i2c_wait();
+  check_all(0);
+
+  twi_model_reset_stats();
+  i2c_reset_stats();
+
+  /* Whole range first, then small moves around the middle, which are mostly
+   * short runs and skipped updates */
+  uint16_t frames_n = 0;
+  uint32_t updates_n = 0;
+  bool backwards = false;
+  srand(1);
+
+  for (uint16_t step = 0; step < SWEEPS_N * 2 * 256 + JITTER_FRAMES_N; ++step) {
+    uint8_t angle;
+
+    if (step < SWEEPS_N * 2 * 256) {
+      angle = (step % 512 < 256) ? step % 512 : 511 - step % 512;
+    }
+    else {
+      angle = 128 + rand() % 5 - 2;
+    }
+
+    /* Each lamp follows its own meter */
+    for (uint8_t n = 0; n < VU_METERS_N; ++n) {
+      uint8_t i = backwards ? VU_METERS_N - 1 - n : n;
+      uint8_t meter = meter_angle(METER_CONFIG_INDICES[i], angle);
+
+      vu_meter_show_peak(&(METERS[i]), meter > 192);
+      updates_n += vu_meter_update(&(METERS[i]), meter);
+    }
+
+    backwards = I2C_MUX && !backwards;
+    ++frames_n;
+
+    if (frames_n % CHECK_PERIOD == 0) {
+      i2c_wait();
+      check_all(frames_n);
+    }
+  }
+
+  i2c_wait();
+  check_all(frames_n);
+
+  twi_model_stats_t stats = twi_model_get_stats();
+  i2c_stats_t queue = i2c_get_stats();
+
+  printf("reads/step %u:  %u frames (%u meter updates, %u skipped)\n", reads_per_step, frames_n,
+    updates_n, VU_METERS_N * frames_n - updates_n);
+  printf("  bytes/frame:        %.1f\n", (double) stats.bytes / frames_n);
+  printf("  starts/frame:       %.2f\n", (double) stats.starts / frames_n);
+  printf("  mux switches/frame: %.2f (%u counted by the queue)\n",
+    (double) stats.mux_switches / frames_n, queue.mux_switches);
+  printf("  buffer switches:    %u (%u stalls)\n", queue.buffer_switches, queue.pending_stalls);
+}
+
+
+int
+main(void)
+{
+  for (uint8_t i = 0; i < sizeof(SPEEDS); ++i) {
+    run(SPEEDS[i]);
+  }
+
+  return 0;
+}
@@ -0,0 +1,48 @@
+#include "display_check.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define DISPLAY_CHECK_CHUNK_WIDTH (32)
+
+
+static bool
+sprite_intersects_page(sprite_t *sprite, uint8_t page, uint8_t column_a, uint8_t column_b)
+{
+  return sprite->visible
+    && page >= sprite->start_page && page <= sprite->end_page
+    && column_b >= sprite->start_column && column_a <= sprite->end_column;
+}
+
+
+void
+display_check(display_t *display, ssd1306_model_t *model, uint16_t frame)
+{
+  ssd1306_segment_t segments[DISPLAY_CHECK_CHUNK_WIDTH];
+
+  for (uint8_t page = 0; page < SSD1306_PAGES_N; ++page) {
+    for (uint8_t column = 0; column < SSD1306_COLUMNS_N; column += DISPLAY_CHECK_CHUNK_WIDTH) {
+      uint8_t column_b = column + DISPLAY_CHECK_CHUNK_WIDTH - 1;
+      memset(segments, 0, DISPLAY_CHECK_CHUNK_WIDTH);
+
+      for (uint8_t i = 0; i < display->sprites_n; ++i) {
+        sprite_t *sprite = display->sprites[i];
+
+        if (sprite_intersects_page(sprite, page, column, column_b)) {
+          sprite->render(sprite, column, page, column_b, segments);
+        }
+      }
+
+      for (uint8_t i = 0; i < DISPLAY_CHECK_CHUNK_WIDTH; ++i) {
+        if (model->framebuffer[page][column + i] != segments[i]) {
+          fprintf(
+            stderr, "frame %u, display %02x: page %u, column %u is %02x, expected %02x\n",
+            frame, model->address, page, column + i, model->framebuffer[page][column + i], segments[i]
+          );
+          exit(1);
+        }
+      }
+    }
+  }
+}
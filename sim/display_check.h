@@ -0,0 +1,14 @@
+#ifndef DISPLAY_CHECK_H
+#define DISPLAY_CHECK_H
+
+#include <stdint.h>
+#include "display.h"
+#include "ssd1306_model.h"
+
+
+/* Compares framebuffer of the model against all sprites of the display
+ * composed from scratch, exits on the first difference */
+void display_check(display_t *display, ssd1306_model_t *model, uint16_t frame);
+
+
+#endif /* DISPLAY_CHECK_H */
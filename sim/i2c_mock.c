@@ -0,0 +1,198 @@
+#include "i2c_mock.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "fault.h"
+
+uint8_t SREG;
+
+
+/* Drop-in replacement of i2c_async.c for the host. Transactions are executed
+ * synchronously, like i2c_sync.c does, and bytes are fed into SSD1306 models.
+ * All of them are on the same wire, there's no I2C_MUX.
+ */
+
+static ssd1306_model_t *I2C_MOCK_DEVICES[I2C_MOCK_MAX_DEVICES];
+static uint8_t I2C_MOCK_DEVICES_N;
+
+static uint8_t I2C_CURRENT_ADDRESS;
+static uint8_t I2C_RESERVED[I2C_RESERVE_MAX];
+static ssd1306_model_t *I2C_CURRENT_DEVICE;
+static bool I2C_IN_TRANSMISSION;
+
+static i2c_mock_stats_t I2C_MOCK_STATS;
+
+
+void
+i2c_mock_attach(ssd1306_model_t *model)
+{
+  if (I2C_MOCK_DEVICES_N == I2C_MOCK_MAX_DEVICES) {
+    fprintf(stderr, "i2c_mock: too many devices\n");
+    abort();
+  }
+
+  I2C_MOCK_DEVICES[I2C_MOCK_DEVICES_N++] = model;
+}
+
+
+void
+i2c_mock_reset_stats(void)
+{
+  I2C_MOCK_STATS = (i2c_mock_stats_t) {0};
+}
+
+
+i2c_mock_stats_t
+i2c_mock_get_stats(void)
+{
+  return I2C_MOCK_STATS;
+}
+
+
+void
+i2c_init(void)
+{
+  /* Nothing to do here */
+}
+
+
+bool
+i2c_is_idle(void)
+{
+  return true;
+}
+
+
+void
+i2c_wait(void)
+{
+  /* Nothing to do here */
+}
+
+
+#if TRAFFIC_STATS
+i2c_stats_t
+i2c_get_stats(void)
+{
+  /* There's no queue */
+  return (i2c_stats_t) {0};
+}
+
+
+void
+i2c_reset_stats(void)
+{
+  /* Nothing to do here */
+}
+#endif
+
+
+void
+i2c_transmit_async(uint8_t channel, uint8_t address, i2c_callback_t callback, void *data)
+{
+  I2C_CURRENT_ADDRESS = address;
+  ++(I2C_MOCK_STATS.transactions);
+  while (callback(data));
+
+  if (I2C_IN_TRANSMISSION) {
+    fprintf(stderr, "i2c_mock: %02x: transaction finished without STOP\n", address);
+    abort();
+  }
+}
+
+
+void
+i2c_async_send_byte(uint8_t data)
+{
+  if (I2C_CURRENT_DEVICE == NULL) {
+    fprintf(stderr, "i2c_mock: byte %02x sent without START\n", data);
+    abort();
+  }
+
+  ++(I2C_MOCK_STATS.bytes);
+  ssd1306_model_receive(I2C_CURRENT_DEVICE, data);
+}
+
+
+void
+i2c_async_send_bytes(uint8_t *data, uint8_t n)
+{
+  for (uint8_t i = 0; i < n; ++i) {
+    i2c_async_send_byte(data[i]);
+  }
+}
+
+
+/* Reserved bytes are sent once committed */
+uint8_t *
+i2c_async_reserve_bytes(uint8_t n)
+{
+  if (n == 0 || n > I2C_RESERVE_MAX) {
+    fprintf(stderr, "i2c_mock: %u bytes can't be reserved\n", n);
+    abort();
+  }
+
+  return I2C_RESERVED;
+}
+
+
+void
+i2c_async_commit_bytes(uint8_t n)
+{
+  i2c_async_send_bytes(I2C_RESERVED, n);
+}
+
+
+/* Bytes are sent right away, so there's no limit */
+uint8_t
+i2c_async_capacity(void)
+{
+  return 0xff;
+}
+
+
+void
+i2c_async_send_start(void)
+{
+  I2C_CURRENT_DEVICE = NULL;
+
+  for (uint8_t i = 0; i < I2C_MOCK_DEVICES_N; ++i) {
+    if (I2C_MOCK_DEVICES[i]->address == I2C_CURRENT_ADDRESS) {
+      I2C_CURRENT_DEVICE = I2C_MOCK_DEVICES[i];
+    }
+  }
+
+  if (I2C_CURRENT_DEVICE == NULL) {
+    fprintf(stderr, "i2c_mock: %02x: address not acknowledged\n", I2C_CURRENT_ADDRESS);
+    abort();
+  }
+
+  ++(I2C_MOCK_STATS.starts);
+  ++(I2C_MOCK_STATS.bytes);
+  I2C_IN_TRANSMISSION = true;
+  ssd1306_model_start(I2C_CURRENT_DEVICE);
+}
+
+
+void
+i2c_async_send_start_to(uint8_t address)
+{
+  I2C_CURRENT_ADDRESS = address;
+  i2c_async_send_start();
+}
+
+
+void
+i2c_async_end_transmission(void)
+{
+  I2C_CURRENT_DEVICE = NULL;
+  I2C_IN_TRANSMISSION = false;
+}
+
+
+void
+lcd_fault(fault_code_t code, uint16_t extended_status, const char *error_text)
+{
+  fprintf(stderr, "fault %02x (%u): %s\n", code, extended_status, error_text);
+  abort();
+}
@@ -0,0 +1,24 @@
+#ifndef I2C_MOCK_H
+#define I2C_MOCK_H
+
+#include <stdint.h>
+#include "i2c.h"
+#include "ssd1306_model.h"
+
+#define I2C_MOCK_MAX_DEVICES (4)
+
+
+/* Every byte on the bus, including address bytes after START */
+typedef struct i2c_mock_stats_t_ {
+  uint32_t transactions;
+  uint32_t starts;
+  uint32_t bytes;
+} i2c_mock_stats_t;
+
+
+void i2c_mock_attach(ssd1306_model_t *model);
+void i2c_mock_reset_stats(void);
+i2c_mock_stats_t i2c_mock_get_stats(void);
+
+
+#endif /* I2C_MOCK_H */
@@ -0,0 +1,232 @@
+#include "needle_check.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <avr/pgmspace.h>
+#include "utils.h"
+#include "needle_coordinates.h"
+#include "needle_sprite.h"
+#include "ssd1306.h"
+
+
+/* Needle as it was drawn before NEEDLE_RASTERS, line traced at runtime for
+ * each row and rendered pixel by pixel. Kept only as a reference. */
+typedef struct reference_needle_t_ {
+  int8_t column[SSD1306_HEIGHT];
+  int8_t start_column[SSD1306_PAGES_N];
+  int8_t end_column[SSD1306_PAGES_N];
+} reference_needle_t;
+
+
+static void
+draw_line_23_octants(int8_t buffer[], uint8_t ax, uint8_t ay, uint8_t bx, uint8_t by)
+{
+  int8_t error = 0;
+  int8_t delta_err = abs(bx - ax);
+  int8_t error_threshold = (by - ay) / 2;
+  int8_t delta_x = (bx > ax) ? 1 : -1;
+  int8_t y;
+
+  for (y = 0; y < ay; ++y) {
+    buffer[y] = -128;
+  }
+
+  for (int8_t y = ay, x = ax; y <= by && y < SSD1306_HEIGHT; ++y) {
+    buffer[y] = x;
+    error += delta_err;
+
+    if (error >= error_threshold) {
+      x += delta_x;
+      error -= error_threshold * 2;
+    }
+  }
+
+  for (y = by + 1; y < SSD1306_HEIGHT; ++y) {
+    buffer[y] = -128;
+  }
+}
+
+
+static void
+reference_needle_render(reference_needle_t *needle, uint8_t column_a, uint8_t page, uint8_t column_b,
+  ssd1306_segment_t* segments)
+{
+  int8_t start_column = needle->start_column[page];
+  int8_t end_column = needle->end_column[page];
+
+  if (start_column == -128) {
+    return;
+  }
+
+  start_column = int_max(start_column, column_a);
+  end_column = int_min(end_column, column_b);
+
+  for (int16_t column = start_column; column <= end_column; ++column) {
+    uint8_t segment = segments[column - column_a];
+
+    for (uint8_t i = 0; i < 8; ++i) {
+      uint8_t row = page * 8 + i;
+
+      if (needle->column[row] < 0) {
+        continue;
+      }
+
+      uint8_t bit = 1 << i;
+      int8_t d = needle->column[row] - column;
+
+      if (d < 0) d = -d;
+
+      if (d == 0) {
+        segment |= bit;
+      }
+      else if (d <= 2) {
+        segment &= ~bit;
+      }
+    }
+
+    segments[column - column_a] = segment;
+  }
+}
+
+
+static void
+reference_needle_draw_index(reference_needle_t *needle, uint8_t index)
+{
+  uint8_t ax = pgm_read_byte(&(NEEDLE_COORDINATES[index].x));
+  uint8_t ay = pgm_read_byte(&(NEEDLE_COORDINATES[index].y));
+
+  draw_line_23_octants(needle->column, ax, ay, NEEDLE_AXIS_X, NEEDLE_AXIS_Y);
+
+  uint8_t page = 0;
+
+  /* Pages over the needle */
+  for (; page < ay / SSD1306_PAGE_HEIGHT; ++page) {
+    needle->start_column[page] = -128;
+    needle->end_column[page] = -128;
+  }
+
+  /* Page, where the needle has it's tip */
+  if (ax <= NEEDLE_AXIS_X) {
+    needle->start_column[page] = ax;
+    needle->end_column[page] = needle->column[(page + 1) * SSD1306_PAGE_HEIGHT - 1];
+  }
+  else {
+    needle->start_column[page] = needle->column[(page + 1) * SSD1306_PAGE_HEIGHT - 1];
+    needle->end_column[page] = ax;
+  }
+
+  ++page;
+
+  /* Pages below the needle tip */
+  for (; page < SSD1306_PAGES_N; ++page) {
+    int8_t top_x = needle->column[page * SSD1306_PAGE_HEIGHT];
+    int8_t bottom_x = needle->column[(page + 1) * SSD1306_PAGE_HEIGHT - 1];
+    needle->start_column[page] = int_min(top_x, bottom_x);
+    needle->end_column[page] = int_max(top_x, bottom_x);
+  }
+
+  /* Take account of needle shadow width */
+  for (page = 0; page < SSD1306_PAGES_N; ++page) {
+    if (needle->start_column[page] == -128) {
+      continue;
+    }
+
+    if (needle->start_column[page] <= 3) {
+      needle->start_column[page] = 0;
+    }
+    else {
+      needle->start_column[page] -= 3;
+    }
+
+    if (needle->end_column[page] >= SSD1306_WIDTH - 3) {
+      needle->end_column[page] = SSD1306_WIDTH - 1;
+    }
+    else {
+      needle->end_column[page] += 3;
+    }
+  }
+}
+
+
+static void
+needle_check_extents(needle_sprite_t *needle, reference_needle_t *reference, uint8_t index)
+{
+  for (uint8_t page = 0; page < SSD1306_PAGES_N; ++page) {
+    const needle_page_raster_t *raster = &(needle->raster->pages[page]);
+    int8_t start_column = pgm_read_byte(&(raster->start_column));
+    int8_t end_column = pgm_read_byte(&(raster->end_column));
+    bool empty = (start_column == -128);
+
+    if (empty != (reference->start_column[page] == -128) ||
+      (!empty && (start_column != reference->start_column[page] || end_column != reference->end_column[page])))
+    {
+      fprintf(
+        stderr, "needle %u: page %u spans %d..%d, expected %d..%d\n",
+        index, page, start_column, end_column, reference->start_column[page], reference->end_column[page]
+      );
+      exit(1);
+    }
+  }
+}
+
+
+/* Chunks are rendered over a background, so both the needle and its shadow
+ * show up, and at several widths, so they're cut at different columns */
+static const ssd1306_segment_t NEEDLE_CHECK_BACKGROUNDS[] = { 0x00, 0xff, 0xa5 };
+static const uint8_t NEEDLE_CHECK_CHUNK_WIDTHS[] = { 32, 7, 1 };
+
+#define NEEDLE_CHECK_N(array) (sizeof(array) / sizeof((array)[0]))
+
+
+static void
+needle_check_segments(needle_sprite_t *needle, reference_needle_t *reference, uint8_t index)
+{
+  ssd1306_segment_t segments[SSD1306_COLUMNS_N];
+  ssd1306_segment_t expected[SSD1306_COLUMNS_N];
+
+  for (uint8_t b = 0; b < NEEDLE_CHECK_N(NEEDLE_CHECK_BACKGROUNDS); ++b) {
+    for (uint8_t w = 0; w < NEEDLE_CHECK_N(NEEDLE_CHECK_CHUNK_WIDTHS); ++w) {
+      uint8_t width = NEEDLE_CHECK_CHUNK_WIDTHS[w];
+
+      for (uint8_t page = 0; page < SSD1306_PAGES_N; ++page) {
+        memset(segments, NEEDLE_CHECK_BACKGROUNDS[b], sizeof(segments));
+        memset(expected, NEEDLE_CHECK_BACKGROUNDS[b], sizeof(expected));
+
+        for (uint16_t column_a = 0; column_a < SSD1306_COLUMNS_N; column_a += width) {
+          uint8_t column_b = int_min(column_a + width - 1, SSD1306_COLUMNS_N - 1);
+
+          needle_sprite_render(&(needle->sprite), column_a, page, column_b, segments + column_a);
+          reference_needle_render(reference, column_a, page, column_b, expected + column_a);
+        }
+
+        for (uint8_t column = 0; column < SSD1306_COLUMNS_N; ++column) {
+          if (segments[column] != expected[column]) {
+            fprintf(
+              stderr, "needle %u over %02x in chunks of %u: page %u, column %u is %02x, expected %02x\n",
+              index, NEEDLE_CHECK_BACKGROUNDS[b], width, page, column, segments[column], expected[column]
+            );
+            exit(1);
+          }
+        }
+      }
+    }
+  }
+}
+
+
+void
+needle_check(void)
+{
+  needle_sprite_t needle;
+  reference_needle_t reference;
+
+  needle_sprite_init(&needle);
+
+  for (uint8_t index = 0; index < NEEDLE_RESOLUTION; ++index) {
+    needle_sprite_draw_index(&needle, index);
+    reference_needle_draw_index(&reference, index);
+
+    needle_check_extents(&needle, &reference, index);
+    needle_check_segments(&needle, &reference, index);
+  }
+}
@@ -0,0 +1,10 @@
+#ifndef NEEDLE_CHECK_H
+#define NEEDLE_CHECK_H
+
+
+/* Compares needle rendered from NEEDLE_RASTERS against the per-pixel renderer
+ * it replaced, for every needle position, exits on the first difference */
+void needle_check(void);
+
+
+#endif /* NEEDLE_CHECK_H */
@@ -0,0 +1,179 @@
+#include "ssd1306_model.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+#define CONTROL_CONTINUATION (0x80)
+#define CONTROL_DATA (0x40)
+
+#define ADDRESSING_HORIZONTAL (0)
+#define ADDRESSING_VERTICAL (1)
+#define ADDRESSING_PAGE (2)
+
+
+void
+ssd1306_model_init(ssd1306_model_t *model, uint8_t address)
+{
+  memset(model, 0, sizeof(ssd1306_model_t));
+  model->address = address;
+  model->addressing_mode = ADDRESSING_PAGE;
+  model->end_column = SSD1306_COLUMNS_N - 1;
+  model->end_page = SSD1306_PAGES_N - 1;
+}
+
+
+void
+ssd1306_model_reset_stats(ssd1306_model_t *model)
+{
+  model->data_bytes = 0;
+  model->command_bytes = 0;
+  model->control_bytes = 0;
+  model->cursor_moves = 0;
+}
+
+
+void
+ssd1306_model_start(ssd1306_model_t *model)
+{
+  model->expect_control_byte = true;
+  model->command_length = 0;
+}
+
+
+static uint8_t
+command_length(uint8_t command)
+{
+  switch (command) {
+    case SSD1306_CMD_SET_COLUMN_ADDRESS:
+    case SSD1306_CMD_SET_PAGE_ADDRESS:
+    case 0xA3: /* Set vertical scroll area */
+      return 3;
+
+    case SSD1306_CMD_SET_MEMORY_ADDRESSING_MODE:
+    case SSD1306_CMD_SET_CONTRAST:
+    case SSD1306_CMD_CHARGE_PUMP_SETTING:
+    case SSD1306_CMD_SET_MULTIPLEX_RATIO:
+    case SSD1306_CMD_SET_DISPLAY_OFFSET:
+    case SSD1306_CMD_SET_CLOCK_DIVIDE_FREQUENCY:
+    case SSD1306_CMD_SET_PRECHARGE_PERIOD:
+    case SSD1306_CMD_SET_COM_PINS_HW_CONF:
+    case SSD1306_CMD_SET_VCOMH_DESELECT_LEVEL:
+      return 2;
+
+    case 0x26: /* Horizontal scroll setup */
+    case 0x27:
+      return 7;
+
+    case 0x29: /* Vertical and horizontal scroll setup */
+    case 0x2A:
+      return 6;
+
+    default:
+      return 1;
+  }
+}
+
+
+static void
+execute_command(ssd1306_model_t *model)
+{
+  uint8_t *command = model->command;
+
+  switch (command[0]) {
+    case SSD1306_CMD_SET_MEMORY_ADDRESSING_MODE:
+      model->addressing_mode = command[1] & 0x03;
+      return;
+
+    case SSD1306_CMD_SET_COLUMN_ADDRESS:
+      model->start_column = command[1] & 0x7f;
+      model->end_column = command[2] & 0x7f;
+      model->column = model->start_column;
+      ++(model->cursor_moves);
+      return;
+
+    case SSD1306_CMD_SET_PAGE_ADDRESS:
+      model->start_page = command[1] & 0x07;
+      model->end_page = command[2] & 0x07;
+      model->page = model->start_page;
+      return;
+  }
+
+  if (model->addressing_mode == ADDRESSING_PAGE) {
+    if ((command[0] & 0xf0) == 0x00) {
+      model->column = (model->column & 0xf0) | (command[0] & 0x0f);
+    }
+    else if ((command[0] & 0xf0) == 0x10) {
+      model->column = ((command[0] & 0x07) << 4) | (model->column & 0x0f);
+      ++(model->cursor_moves);
+    }
+    else if ((command[0] & 0xf8) == 0xb0) {
+      model->page = command[0] & 0x07;
+    }
+  }
+}
+
+
+static void
+write_data(ssd1306_model_t *model, uint8_t byte)
+{
+  model->framebuffer[model->page][model->column] = byte;
+
+  switch (model->addressing_mode) {
+    case ADDRESSING_HORIZONTAL:
+      if (model->column++ == model->end_column) {
+        model->column = model->start_column;
+        model->page = (model->page == model->end_page) ? model->start_page : model->page + 1;
+      }
+      break;
+
+    case ADDRESSING_VERTICAL:
+      if (model->page++ == model->end_page) {
+        model->page = model->start_page;
+        model->column = (model->column == model->end_column) ? model->start_column : model->column + 1;
+      }
+      break;
+
+    default:
+      if (model->column < SSD1306_COLUMNS_N - 1) {
+        ++(model->column);
+      }
+      break;
+  }
+}
+
+
+void
+ssd1306_model_receive(ssd1306_model_t *model, uint8_t byte)
+{
+  if (model->expect_control_byte) {
+    if (byte & ~(CONTROL_CONTINUATION | CONTROL_DATA)) {
+      fprintf(stderr, "ssd1306 %02x: invalid control byte %02x\n", model->address, byte);
+      abort();
+    }
+
+    ++(model->control_bytes);
+    model->single_byte = byte & CONTROL_CONTINUATION;
+    model->data = byte & CONTROL_DATA;
+    model->expect_control_byte = false;
+    return;
+  }
+
+  if (model->data) {
+    ++(model->data_bytes);
+    write_data(model, byte);
+  }
+  else {
+    ++(model->command_bytes);
+    model->command[model->command_length++] = byte;
+
+    if (model->command_length == command_length(model->command[0])) {
+      execute_command(model);
+      model->command_length = 0;
+    }
+  }
+
+  if (model->single_byte) {
+    model->expect_control_byte = true;
+  }
+}
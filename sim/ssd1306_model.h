@@ -0,0 +1,43 @@
+#ifndef SSD1306_MODEL_H
+#define SSD1306_MODEL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "ssd1306.h"
+
+
+/* Software model of SSD1306 controller, receiving bytes of I2C transactions */
+typedef struct ssd1306_model_t_ {
+  uint8_t address;
+  uint8_t framebuffer[SSD1306_PAGES_N][SSD1306_COLUMNS_N];
+
+  uint8_t addressing_mode;
+  uint8_t start_column;
+  uint8_t end_column;
+  uint8_t start_page;
+  uint8_t end_page;
+  uint8_t column;
+  uint8_t page;
+
+  /* Transaction parser */
+  bool expect_control_byte;
+  bool single_byte;
+  bool data;
+  uint8_t command[8];
+  uint8_t command_length;
+
+  /* Statistics */
+  uint32_t data_bytes;
+  uint32_t command_bytes;
+  uint32_t control_bytes;
+  uint32_t cursor_moves;
+} ssd1306_model_t;
+
+
+void ssd1306_model_init(ssd1306_model_t *model, uint8_t address);
+void ssd1306_model_reset_stats(ssd1306_model_t *model);
+void ssd1306_model_start(ssd1306_model_t *model);
+void ssd1306_model_receive(ssd1306_model_t *model, uint8_t byte);
+
+
+#endif /* SSD1306_MODEL_H */
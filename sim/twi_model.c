@@ -0,0 +1,340 @@
+#include "twi_model.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <util/twi.h>
+#include "config.h"
+#include "fault.h"
+
+
+/* Model of the TWI peripheral in master transmitter mode, for the real I2C
+ * driver on the host, with SSD1306 models and TCA9548A on the bus. Writes to
+ * the registers take effect when they're accessed next, or the bus takes a
+ * step. Interrupt handler runs from the step, if TWIE and the interrupt flag
+ * allow, like an interrupt would, with further interrupts disabled.
+ */
+
+#if I2C_ASYNC_FAST_ISR
+#error "Hand written TWI interrupt handler can't run on the host"
+#endif
+
+/* Reserved bit of TWCR, always set by the model. It's gone after TWCR is
+ * assigned, and read-modify-write keeps it, which can't clear TWINT. */
+#define TWI_MODEL_TWCR_RESERVED (0x02)
+
+#define TWI_MODEL_NO_MUX_BYTE (-1)
+
+
+typedef enum twi_model_step_t_ {
+  TWI_MODEL_STEP_NONE,
+  TWI_MODEL_STEP_START,
+  TWI_MODEL_STEP_BYTE
+} twi_model_step_t;
+
+
+typedef struct twi_model_device_t_ {
+  ssd1306_model_t *model;
+  uint8_t channel;
+} twi_model_device_t;
+
+
+typedef struct twi_model_t_ {
+  volatile uint8_t registers[4];
+  bool interrupt_flag;
+  twi_model_step_t step; /* started by software, done by the bus */
+  uint8_t data; /* TWDR when the byte was started */
+
+  uint8_t reads_per_step;
+  uint8_t reads;
+
+  twi_model_device_t devices[TWI_MODEL_MAX_DEVICES];
+  uint8_t devices_n;
+
+  bool in_transaction;
+  bool expect_address;
+  ssd1306_model_t *device; /* addressed */
+  bool mux_addressed;
+  int16_t mux_byte; /* takes effect with STOP */
+  uint8_t mux_channels; /* selected, a bit for each */
+
+  twi_model_stats_t stats;
+} twi_model_t;
+
+
+static twi_model_t TWI_MODEL;
+
+uint8_t SREG;
+
+/* Defined by interrupt driven drivers only */
+void TWI_vect(void) __attribute__((weak));
+
+
+void
+twi_model_init(uint8_t reads_per_step)
+{
+  memset(&TWI_MODEL, 0, sizeof(twi_model_t));
+  TWI_MODEL.registers[TWI_MODEL_TWCR] = TWI_MODEL_TWCR_RESERVED;
+  TWI_MODEL.registers[TWI_MODEL_TWSR] = 0xf8; /* no relevant state */
+  TWI_MODEL.reads_per_step = reads_per_step;
+  TWI_MODEL.mux_byte = TWI_MODEL_NO_MUX_BYTE;
+  /* Mux deselects all channels on reset, and there's just one without it */
+  TWI_MODEL.mux_channels = I2C_MUX ? 0 : 1;
+}
+
+
+void
+twi_model_attach(ssd1306_model_t *model, uint8_t channel)
+{
+  if (TWI_MODEL.devices_n == TWI_MODEL_MAX_DEVICES || channel >= 8 || (!I2C_MUX && channel != 0)) {
+    fprintf(stderr, "twi_model: %02x can't be attached to channel %u\n", model->address, channel);
+    abort();
+  }
+
+  TWI_MODEL.devices[TWI_MODEL.devices_n++] = (twi_model_device_t) { model, channel };
+}
+
+
+void
+twi_model_reset_stats(void)
+{
+  TWI_MODEL.stats = (twi_model_stats_t) {0};
+}
+
+
+twi_model_stats_t
+twi_model_get_stats(void)
+{
+  return TWI_MODEL.stats;
+}
+
+
+static void
+twi_model_fail(const char *message)
+{
+  fprintf(stderr, "twi_model: %s\n", message);
+  abort();
+}
+
+
+/* Only a single device can answer to an address */
+static ssd1306_model_t *
+twi_model_select(uint8_t address)
+{
+  ssd1306_model_t *selected = NULL;
+
+  for (uint8_t i = 0; i < TWI_MODEL.devices_n; ++i) {
+    twi_model_device_t *device = &(TWI_MODEL.devices[i]);
+
+    if (device->model->address == address && (TWI_MODEL.mux_channels & (1 << device->channel))) {
+      if (selected != NULL) {
+        twi_model_fail("more than one device answers to the address");
+      }
+
+      selected = device->model;
+    }
+  }
+
+  return selected;
+}
+
+
+static void
+twi_model_stop(void)
+{
+  if (!TWI_MODEL.in_transaction) {
+    twi_model_fail("STOP outside of transaction");
+  }
+
+  if (TWI_MODEL.mux_addressed) {
+    if (TWI_MODEL.mux_byte == TWI_MODEL_NO_MUX_BYTE) {
+      twi_model_fail("mux addressed without channel selection");
+    }
+
+    TWI_MODEL.mux_channels = TWI_MODEL.mux_byte;
+    ++(TWI_MODEL.stats.mux_switches);
+  }
+
+  TWI_MODEL.in_transaction = false;
+  TWI_MODEL.device = NULL;
+  TWI_MODEL.mux_addressed = false;
+  TWI_MODEL.mux_byte = TWI_MODEL_NO_MUX_BYTE;
+  ++(TWI_MODEL.stats.transactions);
+}
+
+
+/* Returns status of the byte */
+static uint8_t
+twi_model_receive(uint8_t byte)
+{
+  ++(TWI_MODEL.stats.bytes);
+
+  if (TWI_MODEL.expect_address) {
+    TWI_MODEL.expect_address = false;
+
+    if (I2C_MUX && byte == I2C_MUX_ADDRESS) {
+      TWI_MODEL.mux_addressed = true;
+      return TW_MT_SLA_ACK;
+    }
+
+    TWI_MODEL.device = twi_model_select(byte);
+
+    if (TWI_MODEL.device == NULL) {
+      return TW_MT_SLA_NACK;
+    }
+
+    ssd1306_model_start(TWI_MODEL.device);
+    return TW_MT_SLA_ACK;
+  }
+
+  if (TWI_MODEL.mux_addressed) {
+    if (TWI_MODEL.mux_byte != TWI_MODEL_NO_MUX_BYTE) {
+      twi_model_fail("more than one byte sent to mux");
+    }
+
+    TWI_MODEL.mux_byte = byte;
+    return TW_MT_DATA_ACK;
+  }
+
+  if (TWI_MODEL.device == NULL) {
+    twi_model_fail("byte sent after address wasn't acknowledged");
+  }
+
+  ssd1306_model_receive(TWI_MODEL.device, byte);
+  return TW_MT_DATA_ACK;
+}
+
+
+/* Takes what was written to TWCR since it was last seen */
+static void
+twi_model_catch_up(void)
+{
+  volatile uint8_t *twcr = &(TWI_MODEL.registers[TWI_MODEL_TWCR]);
+  uint8_t value = *twcr;
+
+  if (!(value & TWI_MODEL_TWCR_RESERVED) && (value & _BV(TWINT))) {
+    if (TWI_MODEL.step != TWI_MODEL_STEP_NONE || !(TWI_MODEL.interrupt_flag || !TWI_MODEL.in_transaction)) {
+      twi_model_fail("TWCR written before the previous step was done");
+    }
+
+    TWI_MODEL.interrupt_flag = false;
+
+    if (value & _BV(TWSTO)) {
+      /* Done right away, TWINT isn't set after STOP */
+      twi_model_stop();
+      value &= ~_BV(TWSTO);
+    }
+    else if (value & _BV(TWSTA)) {
+      TWI_MODEL.step = TWI_MODEL_STEP_START;
+    }
+    else {
+      if (!TWI_MODEL.in_transaction) {
+        twi_model_fail("byte sent outside of transaction");
+      }
+
+      TWI_MODEL.step = TWI_MODEL_STEP_BYTE;
+      TWI_MODEL.data = TWI_MODEL.registers[TWI_MODEL_TWDR];
+    }
+  }
+
+  *twcr = (value & ~_BV(TWINT)) | TWI_MODEL_TWCR_RESERVED | (TWI_MODEL.interrupt_flag ? _BV(TWINT) : 0);
+}
+
+
+static void
+twi_model_step(void)
+{
+  twi_model_catch_up();
+
+  switch (TWI_MODEL.step) {
+    case TWI_MODEL_STEP_NONE:
+      return;
+
+    case TWI_MODEL_STEP_START:
+      TWI_MODEL.registers[TWI_MODEL_TWSR] = TWI_MODEL.in_transaction ? TW_REP_START : TW_START;
+      TWI_MODEL.in_transaction = true;
+      TWI_MODEL.expect_address = true;
+      TWI_MODEL.device = NULL;
+      ++(TWI_MODEL.stats.starts);
+      break;
+
+    case TWI_MODEL_STEP_BYTE:
+      TWI_MODEL.registers[TWI_MODEL_TWSR] = twi_model_receive(TWI_MODEL.data);
+      break;
+  }
+
+  TWI_MODEL.step = TWI_MODEL_STEP_NONE;
+  TWI_MODEL.interrupt_flag = true;
+  TWI_MODEL.registers[TWI_MODEL_TWCR] |= _BV(TWINT);
+}
+
+
+/* Returns true if the handler was run */
+static bool
+twi_model_interrupt(void)
+{
+  twi_model_catch_up();
+
+  if (TWI_MODEL.interrupt_flag && (TWI_MODEL.registers[TWI_MODEL_TWCR] & _BV(TWIE)) &&
+    (SREG & _BV(SREG_I)) && TWI_vect)
+  {
+    cli();
+    TWI_vect();
+    sei();
+    return true;
+  }
+
+  return false;
+}
+
+
+volatile uint8_t *
+twi_model_register(twi_model_register_t reg)
+{
+  twi_model_catch_up();
+
+#if I2C_DRIVER != I2C_DRIVER_ASYNC
+  if (reg == TWI_MODEL_TWCR) {
+    twi_model_step();
+  }
+#endif
+
+  return &(TWI_MODEL.registers[reg]);
+}
+
+
+uint8_t
+twi_model_read_byte(const void *address)
+{
+  if (TWI_MODEL.reads_per_step && ++(TWI_MODEL.reads) == TWI_MODEL.reads_per_step) {
+    TWI_MODEL.reads = 0;
+    twi_model_step();
+    twi_model_interrupt();
+  }
+
+  return *(const uint8_t *) address;
+}
+
+
+/* Only TWI interrupt can wake the CPU up, as if nothing else changed */
+void
+twi_model_sleep(void)
+{
+  while (!twi_model_interrupt()) {
+    if (TWI_MODEL.step == TWI_MODEL_STEP_NONE) {
+      twi_model_fail("CPU sleeps with nothing to wake it up");
+    }
+
+    twi_model_step();
+  }
+}
+
+
+void
+lcd_fault(fault_code_t code, uint16_t extended_status, const char *error_text)
+{
+  fprintf(stderr, "fault %02x (%u): %s\n", code, extended_status, error_text);
+  abort();
+}
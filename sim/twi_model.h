@@ -0,0 +1,31 @@
+#ifndef TWI_MODEL_H
+#define TWI_MODEL_H
+
+#include <stdint.h>
+#include "ssd1306_model.h"
+
+#define TWI_MODEL_MAX_DEVICES (8)
+
+
+/* Every byte on the bus, including address bytes after START */
+typedef struct twi_model_stats_t_ {
+  uint32_t transactions;
+  uint32_t starts;
+  uint32_t bytes;
+  uint32_t mux_switches;
+} twi_model_stats_t;
+
+
+/* Bus takes a step, a START or a byte, every `reads_per_step` reads of
+ * program memory, or only while the CPU sleeps if it's 0. Busy waiting
+ * drivers see a step done with each poll of TWCR. */
+void twi_model_init(uint8_t reads_per_step);
+
+/* Devices answer only when their channel of I2C_MUX is selected, without it
+ * the channel is 0 */
+void twi_model_attach(ssd1306_model_t *model, uint8_t channel);
+void twi_model_reset_stats(void);
+twi_model_stats_t twi_model_get_stats(void);
+
+
+#endif /* TWI_MODEL_H */
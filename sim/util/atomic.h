@@ -0,0 +1,23 @@
+#ifndef SIM_UTIL_ATOMIC_H
+#define SIM_UTIL_ATOMIC_H
+
+#include <avr/io.h>
+
+/* Same as avr-libc, interrupt flag is restored or forced when the block is
+ * left, in any way */
+
+static inline void sim_atomic_restore_(const uint8_t *sreg) { SREG = *sreg; }
+static inline void sim_atomic_force_on_(const uint8_t *sreg) { (void) sreg; SREG |= _BV(SREG_I); }
+static inline void sim_atomic_force_off_(const uint8_t *sreg) { (void) sreg; SREG &= ~_BV(SREG_I); }
+static inline uint8_t sim_atomic_cli_(void) { SREG &= ~_BV(SREG_I); return 1; }
+static inline uint8_t sim_atomic_sei_(void) { SREG |= _BV(SREG_I); return 1; }
+
+#define ATOMIC_BLOCK(type) for (type, atomic_once_ = sim_atomic_cli_(); atomic_once_; atomic_once_ = 0)
+#define NONATOMIC_BLOCK(type) for (type, nonatomic_once_ = sim_atomic_sei_(); nonatomic_once_; nonatomic_once_ = 0)
+
+#define ATOMIC_RESTORESTATE uint8_t sreg_save_ __attribute__((cleanup(sim_atomic_restore_))) = SREG
+#define ATOMIC_FORCEON uint8_t sreg_save_ __attribute__((cleanup(sim_atomic_force_on_))) = 0
+#define NONATOMIC_RESTORESTATE uint8_t sreg_save_ __attribute__((cleanup(sim_atomic_restore_))) = SREG
+#define NONATOMIC_FORCEOFF uint8_t sreg_save_ __attribute__((cleanup(sim_atomic_force_off_))) = 0
+
+#endif /* SIM_UTIL_ATOMIC_H */
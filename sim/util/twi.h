@@ -0,0 +1,14 @@
+#ifndef SIM_UTIL_TWI_H
+#define SIM_UTIL_TWI_H
+
+/* Master transmitter status codes, as in avr-libc */
+#define TW_STATUS_MASK (0xf8)
+#define TW_START (0x08)
+#define TW_REP_START (0x10)
+#define TW_MT_SLA_ACK (0x18)
+#define TW_MT_SLA_NACK (0x20)
+#define TW_MT_DATA_ACK (0x28)
+#define TW_MT_DATA_NACK (0x30)
+#define TW_MT_ARB_LOST (0x38)
+
+#endif /* SIM_UTIL_TWI_H */
@@ -2,33 +2,225 @@
 
 #include <stdbool.h>
 #include <avr/interrupt.h>
+#include <avr/eeprom.h>
 #include <util/atomic.h>
+#include "config.h"
+#include "ballistics.h"
+#include "ring_buffer.h"
+#include "transfer_curve.h"
 
 
-uint16_t
-adc_get(uint8_t channel)
+/* Conversions are triggered by Timer/Counter0 compare match, alternating
+ * between channels, so each one is sampled at ADC_SAMPLE_RATE. */
+#define ADC_TIMER_PRESCALER (64)
+#define ADC_TIMER_TOP (F_CPU / ADC_TIMER_PRESCALER / (ADC_SAMPLE_RATE * ADC_CHANNELS_N) - 1)
+
+#if ADC_TIMER_TOP > 255 || ADC_TIMER_TOP < 1
+#error "ADC_SAMPLE_RATE is out of range of Timer/Counter0"
+#endif
+
+#define ADC_PEAK_HOLD_SAMPLES ((uint16_t) ((uint32_t) ADC_PEAK_HOLD_MS * ADC_SAMPLE_RATE / 1000))
+
+
+/* Last samples of single channel, written only by the interrupt handler,
+ * which drops the oldest one when it's full. So it writes tail as well, and
+ * samples are read only with interrupts disabled. */
+RING_BUFFER_DEFINE(adc_samples, uint16_t, ADC_SAMPLES_N)
+
+
+/* Highest rectified input, held for a while and then decaying. Only the flag
+ * is read outside of the interrupt handler. */
+typedef struct adc_peak_t_ {
+  uint16_t level;
+  uint16_t hold;
+  volatile bool detected;
+} adc_peak_t;
+
+
+static const uint8_t ADC_INPUTS[ADC_CHANNELS_N] = { ADC_INPUT_L, ADC_INPUT_R };
+
+/* Zero level of each channel, measured with no signal. Erased cells mean it
+ * wasn't calibrated. */
+#define ADC_ZERO_NOT_CALIBRATED (0xffff)
+
+static uint16_t ADC_ZERO_CALIBRATION[ADC_CHANNELS_N] EEMEM = { ADC_ZERO, ADC_ZERO };
+static uint16_t ADC_ZEROS[ADC_CHANNELS_N];
+
+static adc_samples_t ADC_SAMPLES[ADC_CHANNELS_N];
+static adc_peak_t ADC_PEAKS[ADC_CHANNELS_N];
+#if BALLISTICS
+static ballistics_t ADC_BALLISTICS[ADC_CHANNELS_N];
+#endif
+static uint8_t ADC_CURRENT_CHANNEL;
+
+
+void
+adc_start_sampling(void)
 {
   ADMUX = 0;
   ADCSRA = 0;
   ADCSRB = 0;
 
-  /* Input is selected based on channel */
-  DDRC &= ~_BV(channel);
-  ADMUX |= channel;
+  for (uint8_t i = 0; i < ADC_CHANNELS_N; ++i) {
+    DDRC &= ~_BV(ADC_INPUTS[i]);
+    adc_samples_init(&(ADC_SAMPLES[i]));
+    ADC_PEAKS[i] = (adc_peak_t) {0};
+
+    ADC_ZEROS[i] = eeprom_read_word(&(ADC_ZERO_CALIBRATION[i]));
+
+    if (ADC_ZEROS[i] == ADC_ZERO_NOT_CALIBRATED) {
+      ADC_ZEROS[i] = ADC_ZERO;
+    }
+  }
+
+#if BALLISTICS
+  for (uint8_t i = 0; i < ADC_CHANNELS_N; ++i) {
+    ballistics_init(&(ADC_BALLISTICS[i]), ADC_ZEROS[i]);
+  }
+#endif
+
+  ADC_CURRENT_CHANNEL = ADC_CHANNEL_L;
+  ADMUX |= ADC_INPUTS[ADC_CURRENT_CHANNEL];
+
+  /* Timer/Counter0: Mode 2 (CTC), TOP = OCR0A, Clock Source = CLK/64 */
+  TCCR0A = _BV(WGM01);
+  TCCR0B = 0;
+  TIMSK0 = 0;
+  OCR0A = ADC_TIMER_TOP;
+  TCCR0B |= _BV(CS01) | _BV(CS00);
+
+  /* Trigger conversion on Timer/Counter0 Compare Match A */
+  ADCSRB |= _BV(ADTS1) | _BV(ADTS0);
 
   /* Set clock to CLK/128 = 156.25kHz */
   ADCSRA |= _BV(ADPS2) | _BV(ADPS1) | _BV(ADPS0);
 
-  /* Enable ADC and start continuous conversion */
-  ADCSRA |= _BV(ADEN) | _BV(ADSC);
+  /* Enable ADC with auto trigger and conversion complete interrupt */
+  ADCSRA |= _BV(ADEN) | _BV(ADATE) | _BV(ADIE);
+}
 
-  while (ADCSRA & _BV(ADSC));
 
-  uint16_t result = ADC;
+uint16_t
+adc_get_latest(adc_channel_t channel)
+{
+  adc_samples_t *samples = &(ADC_SAMPLES[channel]);
+  uint16_t result = 0;
 
-  ADMUX = 0;
-  ADCSRA = 0;
-  ADCSRB = 0;
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    if (!adc_samples_is_empty(samples)) {
+      result = *(adc_samples_get_newest(samples, 0));
+    }
+  }
+
+  return result;
+}
+
+
+uint16_t
+adc_get_average(adc_channel_t channel)
+{
+  adc_samples_t *samples = &(ADC_SAMPLES[channel]);
+  uint16_t sum = 0;
+  uint8_t samples_n = 0;
+
+  /* 10 bit samples, so up to 64 of them fit. Only samples stored so far are
+   * averaged, right after start the buffer isn't full yet. */
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    samples_n = adc_samples_get_size(samples);
+
+    for (uint8_t i = 0; i < samples_n; ++i) {
+      sum += *(adc_samples_get_newest(samples, i));
+    }
+  }
+
+  /* Needle stays at rest until the first conversion */
+  if (samples_n == 0) {
+    return ADC_ZEROS[channel];
+  }
+
+  return sum / samples_n;
+}
+
+
+/* Rectified average is shown right away, if the needle isn't simulated */
+uint8_t
+adc_get_needle_angle(adc_channel_t channel)
+{
+#if BALLISTICS
+  uint8_t result = 0;
+
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    result = ballistics_get_angle(&(ADC_BALLISTICS[channel]));
+  }
 
   return result;
+#else
+  int16_t input = (int16_t) adc_get_average(channel) - (int16_t) ADC_ZEROS[channel];
+
+  if (input < 0) {
+    input = -input;
+  }
+
+  return transfer_curve_get_angle(input);
+#endif
+}
+
+
+bool
+adc_is_peak(adc_channel_t channel)
+{
+  return ADC_PEAKS[channel].detected;
+}
+
+
+static inline void
+adc_detect_peak(adc_peak_t *peak, uint16_t sample, uint16_t zero)
+{
+  int16_t input = (int16_t) sample - (int16_t) zero;
+
+  if (input < 0) {
+    input = -input;
+  }
+
+  if ((uint16_t) input >= peak->level) {
+    peak->level = input;
+    peak->hold = ADC_PEAK_HOLD_SAMPLES;
+  }
+  else if (peak->hold > 0) {
+    --(peak->hold);
+  }
+  else {
+    peak->level = (peak->level > ADC_PEAK_DECAY) ? peak->level - ADC_PEAK_DECAY : 0;
+  }
+
+  peak->detected = (peak->level >= ADC_PEAK_THRESHOLD);
+}
+
+
+ISR(ADC_vect)
+{
+  adc_samples_t *samples = &(ADC_SAMPLES[ADC_CURRENT_CHANNEL]);
+  uint16_t sample = ADC;
+
+  if (adc_samples_is_full(samples)) {
+    adc_samples_discard(samples);
+  }
+
+  adc_samples_push(samples, sample);
+
+  /* Next conversion starts on next compare match, so input can be switched
+   * right away. Compare match flag has to be cleared to allow the trigger. */
+  ADC_CURRENT_CHANNEL ^= 1;
+  ADMUX = (ADMUX & 0xf0) | ADC_INPUTS[ADC_CURRENT_CHANNEL];
+  TIFR0 = _BV(OCF0A);
+
+  uint8_t channel = ADC_CURRENT_CHANNEL ^ 1;
+
+  /* Rest of the handler doesn't have to block other interrupts */
+  NONATOMIC_BLOCK(NONATOMIC_FORCEOFF) {
+    adc_detect_peak(&(ADC_PEAKS[channel]), sample, ADC_ZEROS[channel]);
+#if BALLISTICS
+    ballistics_step(&(ADC_BALLISTICS[channel]), sample);
+#endif
+  }
 }
@@ -1,10 +1,25 @@
 #ifndef _ADC_H_
 #define _ADC_H_
 
+#include <stdbool.h>
 #include <stdint.h>
+#include "config.h"
 
 
-uint16_t adc_get(uint8_t channel);
+#define ADC_CHANNELS_N (2)
+
+typedef enum adc_channel_t_ {
+  ADC_CHANNEL_L = 0,
+  ADC_CHANNEL_R = 1
+} adc_channel_t;
+
+
+void adc_start_sampling(void);
+uint16_t adc_get_latest(adc_channel_t channel);
+uint16_t adc_get_average(adc_channel_t channel);
+
+uint8_t adc_get_needle_angle(adc_channel_t channel);
+bool adc_is_peak(adc_channel_t channel);
 
 
 #endif
@@ -0,0 +1,39 @@
+#include <stdint.h>
+#include <avr/pgmspace.h>
+
+const uint8_t BACKGROUND_RLE[323] PROGMEM = {
+  0x80, /* = width */
+  0x40, /* = height */
+  /* page offsets */
+  0x00, 0x00, 0x0a, 0x00, 0x38, 0x00, 0x74, 0x00, 0xae, 0x00, 0xe8, 0x00, 0x01, 0x01, 0x1a, 0x01,
+  /* page 0 */
+  0x83, 0x04, 0xf6, 0x00, 0x04, 0x04, 0x04, 0x1f, 0x04, 0x04,
+  /* page 1 */
+  0x85, 0x00, 0x06, 0xd0, 0x50, 0x70, 0x00, 0xf0, 0x10, 0xf0, 0x92, 0x00, 0x04, 0xf0, 0x00, 0xf0,
+  0x10, 0xf0, 0x98, 0x00, 0x02, 0x50, 0x50, 0xf0, 0x93, 0x00, 0x02, 0xf0, 0x10, 0xf0, 0x86, 0x00,
+  0x00, 0xf0, 0x8a, 0x00, 0x02, 0xd0, 0x50, 0x70, 0x8e, 0x00, 0x02, 0x50, 0x50, 0xf0,
+  /* page 2 */
+  0x85, 0x00, 0x82, 0x01, 0x00, 0x78, 0x82, 0x41, 0x92, 0x40, 0x04, 0x41, 0x40, 0x79, 0x41, 0x41,
+  0x86, 0x40, 0x00, 0x60, 0x87, 0x40, 0x00, 0x60, 0x87, 0x40, 0x02, 0x41, 0x79, 0x41, 0x84, 0x40,
+  0x00, 0x60, 0x85, 0x40, 0x00, 0x60, 0x86, 0x40, 0x02, 0x41, 0x79, 0x01, 0x86, 0x60, 0x00, 0x79,
+  0x8a, 0x60, 0x02, 0x61, 0x79, 0x61, 0x8e, 0x60, 0x02, 0x61, 0x79, 0x01,
+  /* page 3 */
+  0x02, 0xc0, 0x4e, 0xc2, 0x90, 0x02, 0x06, 0x42, 0x42, 0xc2, 0x06, 0xc2, 0x42, 0xc2, 0x89, 0x02,
+  0x06, 0xc2, 0x02, 0x82, 0x06, 0xc2, 0x42, 0xc2, 0x88, 0x02, 0x06, 0xc2, 0x42, 0x42, 0x06, 0xc2,
+  0x42, 0xc2, 0x86, 0x02, 0x06, 0xc2, 0x42, 0xc2, 0x06, 0xc2, 0x42, 0xc2, 0x87, 0x02, 0x08, 0xc2,
+  0x02, 0xc2, 0x42, 0xce, 0x00, 0xc0, 0x40, 0xc0, 0xa4, 0x00,
+  /* page 4 */
+  0x02, 0x07, 0x04, 0x07, 0x90, 0x00, 0x06, 0x07, 0x05, 0x05, 0x00, 0x07, 0x04, 0x07, 0x89, 0x00,
+  0x06, 0x03, 0x02, 0x07, 0x00, 0x07, 0x04, 0x07, 0x88, 0x00, 0x06, 0x07, 0x05, 0x07, 0x00, 0x07,
+  0x04, 0x07, 0x86, 0x00, 0x06, 0x07, 0x05, 0x07, 0x00, 0x07, 0x04, 0x07, 0x87, 0x00, 0x08, 0x07,
+  0x00, 0x07, 0x04, 0x07, 0x00, 0x07, 0x04, 0x07, 0xa4, 0x00,
+  /* page 5 */
+  0xb5, 0x00, 0x02, 0xf8, 0x04, 0xf8, 0x82, 0x00, 0x07, 0xf8, 0x04, 0xf8, 0x00, 0x00, 0xf8, 0x04,
+  0xf8, 0x82, 0x00, 0x02, 0xf8, 0x04, 0xf8, 0xb5, 0x00,
+  /* page 6 */
+  0xb5, 0x00, 0x0d, 0x0f, 0x10, 0x2f, 0x50, 0xa0, 0x50, 0x2f, 0x10, 0x0f, 0x00, 0x00, 0x3f, 0x40,
+  0xbf, 0x82, 0xa0, 0x02, 0xbf, 0x40, 0x3f, 0xb5, 0x00,
+  /* page 7 */
+  0xeb, 0x00, 0x13, 0x7e, 0x22, 0x22, 0x3e, 0x00, 0x7e, 0x52, 0x42, 0x42, 0x00, 0x7e, 0x12, 0x12,
+  0x7e, 0x00, 0x7e, 0x10, 0x10, 0x6e, 0x00,
+};
@@ -0,0 +1,62 @@
+#include "ballistics.h"
+#include "config.h"
+#include "transfer_curve.h"
+
+
+/* Coefficients of the discrete model, both scaled by 2^24:
+ *
+ *   velocity += K * (target - position) - D * velocity
+ *   position += velocity
+ *
+ * with K = (w / fs)^2 and D = 2 * zeta * w / fs. Computed by the compiler, so
+ * there's no floating point arithmetic left in the firmware.
+ */
+#define BALLISTICS_K ((int32_t) (BALLISTICS_NATURAL_FREQUENCY * BALLISTICS_NATURAL_FREQUENCY \
+  / ((double) ADC_SAMPLE_RATE * ADC_SAMPLE_RATE) * 16777216.0 + 0.5))
+#define BALLISTICS_D ((int32_t) (2.0 * BALLISTICS_DAMPING_RATIO * BALLISTICS_NATURAL_FREQUENCY \
+  / ADC_SAMPLE_RATE * 16777216.0 + 0.5))
+
+
+void
+ballistics_init(ballistics_t *ballistics, uint16_t adc_zero)
+{
+  ballistics->position = 0;
+  ballistics->velocity = 0;
+  ballistics->adc_zero = adc_zero;
+}
+
+
+/* Called from ADC interrupt handler for each sample, so multiplications and
+ * shifts only. Terms are scaled down by 2^8 before multiplying, to fit into
+ * 32 bits.
+ */
+void
+ballistics_step(ballistics_t *ballistics, uint16_t sample)
+{
+  int16_t input = (int16_t) sample - (int16_t) ballistics->adc_zero;
+
+  if (input < 0) {
+    input = -input;
+  }
+
+  int32_t target = (int32_t) input << 16;
+  int32_t error = target - ballistics->position;
+  int32_t acceleration = (((error >> 8) * BALLISTICS_K) >> 16) -
+    (((ballistics->velocity >> 8) * BALLISTICS_D) >> 16);
+
+  ballistics->velocity += acceleration;
+  ballistics->position += ballistics->velocity;
+}
+
+
+uint8_t
+ballistics_get_angle(ballistics_t *ballistics)
+{
+  int16_t magnitude = ballistics->position >> 16;
+
+  if (magnitude < 0) {
+    magnitude = 0;
+  }
+
+  return transfer_curve_get_angle(magnitude);
+}
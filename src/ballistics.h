@@ -0,0 +1,24 @@
+#ifndef BALLISTICS_H
+#define BALLISTICS_H
+
+#include <stdint.h>
+#include "config.h"
+
+
+/* Needle is simulated as a damped spring, position and velocity are in
+ * ADC codes of rectified input with 16 fractional bits, velocity is per
+ * sample. Position is mapped to needle angle by the transfer curve.
+ */
+typedef struct ballistics_t_ {
+  int32_t position;
+  int32_t velocity;
+  uint16_t adc_zero;
+} ballistics_t;
+
+
+void ballistics_init(ballistics_t *ballistics, uint16_t adc_zero);
+void ballistics_step(ballistics_t *ballistics, uint16_t sample);
+uint8_t ballistics_get_angle(ballistics_t *ballistics);
+
+
+#endif /* BALLISTICS_H */
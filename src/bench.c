@@ -0,0 +1,242 @@
+#include <avr/interrupt.h>
+#include <avr/pgmspace.h>
+#include <util/delay.h>
+#include "config.h"
+#include "i2c.h"
+#include "spi.h"
+#include "lcd.h"
+#include "images.h"
+#include "ssd1306.h"
+#include "display.h"
+#include "progmem_image_sprite.h"
+#include "progmem_rle_image_sprite.h"
+#include "needle_sprite.h"
+#include "vu_meter.h"
+#include "benchmark.h"
+#include "probe.h"
+
+
+/* Benchmark firmware, built by `make bench`. Fixed scenarios are run one
+ * after another, as fast as the bus allows, each from the same state, and
+ * results are shown on the LCD:
+ *
+ *   name       fps
+ *   time  bytes/frame
+ *
+ * followed by each probe, if enabled. ADC isn't sampled, so nothing but the
+ * scenario itself takes the CPU.
+ */
+#define BENCH_SCENARIOS(X) \
+  X(sweep, "sweep", 256) \
+  X(jitter, "jitter", 256) \
+  X(peak, "peak", 128) \
+  X(redraw, "redraw", 16) \
+  X(interleave, "interleave", 256)
+
+#define BENCH_RESULT_MS (3000)
+#define BENCH_PROBE_MS (2000)
+
+/* Needle moves by one position back and forth, just past the hysteresis */
+#define BENCH_JITTER (256 / NEEDLE_RESOLUTION + NEEDLE_HYSTERESIS)
+
+
+#if BACKGROUND_COMPRESSED
+progmem_rle_image_sprite_t BACKGROUND_SPRITE;
+#else
+progmem_image_sprite_t BACKGROUND_SPRITE;
+#endif
+vu_meter_t METERS[VU_METERS_N];
+uint8_t METER_CONFIG_INDICES[VU_METERS_N];
+
+
+typedef void (*bench_frame_t)(uint16_t frame);
+
+
+/* Goes from 0 to full scale and back */
+static uint8_t
+bench_triangle(uint16_t frame, uint16_t frames_n)
+{
+  uint16_t half = frames_n / 2;
+  uint16_t position = (frame < half) ? frame : frames_n - 1 - frame;
+
+  return position * 255 / (half - 1);
+}
+
+
+static void
+bench_show_peak(bool visible)
+{
+  for (uint8_t i = 0; i < VU_METERS_N; ++i) {
+    vu_meter_show_peak(&(METERS[i]), visible);
+  }
+}
+
+
+/* First meter is given the angle, others stay at zero */
+static void
+bench_update_first(uint8_t angle)
+{
+  vu_meter_update(&(METERS[0]), angle);
+
+  for (uint8_t i = 1; i < VU_METERS_N; ++i) {
+    vu_meter_update(&(METERS[i]), 0);
+  }
+}
+
+
+static void
+bench_sweep(uint16_t frame)
+{
+  bench_update_first(bench_triangle(frame, 256));
+}
+
+
+static void
+bench_jitter(uint16_t frame)
+{
+  bench_update_first((frame & 1) ? 128 + BENCH_JITTER : 128 - BENCH_JITTER);
+}
+
+
+static void
+bench_peak(uint16_t frame)
+{
+  bench_show_peak(frame & 1);
+  bench_update_first(0);
+}
+
+
+static void
+bench_redraw(uint16_t frame)
+{
+  for (uint8_t i = 0; i < VU_METERS_N; ++i) {
+    display_wait(&(METERS[i].display));
+    display_update_async(&(METERS[i].display));
+  }
+}
+
+
+/* All meters move each frame, every other one going the other way */
+static void
+bench_interleave(uint16_t frame)
+{
+  for (uint8_t i = 0; i < VU_METERS_N; ++i) {
+    uint8_t angle = bench_triangle(frame, 256);
+
+    vu_meter_update(&(METERS[i]), (i & 1) ? 255 - angle : angle);
+  }
+}
+
+
+static void
+bench_reset(void)
+{
+  bench_show_peak(false);
+  bench_update_first(0);
+  i2c_wait();
+
+#if TRAFFIC_STATS
+  for (uint8_t i = 0; i < VU_METERS_N; ++i) {
+    ssd1306_reset_stats(&(METERS[i].device));
+  }
+
+  i2c_reset_stats();
+#endif
+#if PROBES_ENABLED
+  for (uint8_t id = 0; id < PROBES_N; ++id) {
+    probe_reset(id);
+  }
+#endif
+}
+
+
+#if TRAFFIC_STATS
+static uint32_t
+bench_bytes_sent(void)
+{
+  uint32_t bytes = 0;
+
+  for (uint8_t i = 0; i < VU_METERS_N; ++i) {
+    ssd1306_stats_t *stats = &(METERS[i].device.stats);
+
+    bytes += (uint32_t) stats->address_bytes + stats->control_bytes + stats->cursor_bytes +
+      stats->payload_bytes;
+  }
+
+  return bytes;
+}
+#endif
+
+
+static void
+bench_run(const char *name, bench_frame_t frame, uint16_t frames_n)
+{
+  bench_reset();
+
+  time_t start = get_current_time();
+
+  for (uint16_t i = 0; i < frames_n; ++i) {
+    frame(i);
+  }
+
+  i2c_wait();
+
+  time_t time = get_current_time() - start;
+
+#if LCD_ENABLED
+  lcd_clear();
+  lcd_puts_P(name);
+  lcd_putc(' ');
+  lcd_put_long((int32_t) frames_n * 1000000 / time);
+  lcd_puts("fps");
+  lcd_goto(0, 1);
+  lcd_put_long(time / 1000);
+  lcd_puts("ms");
+#if TRAFFIC_STATS
+  lcd_putc(' ');
+  lcd_put_long(bench_bytes_sent() / frames_n);
+  lcd_puts("B/f");
+#endif
+  _delay_ms(BENCH_RESULT_MS);
+#else
+  (void) time;
+#endif
+
+#if PROBES_ENABLED
+  for (uint8_t id = 0; id < PROBES_N; ++id) {
+    probe_dump_next();
+    _delay_ms(BENCH_PROBE_MS);
+  }
+#endif
+}
+
+
+int main(void)
+{
+#if LCD_ENABLED
+  lcd_init();
+#endif
+  i2c_init();
+#if DISPLAY_TRANSPORT == DISPLAY_TRANSPORT_SPI
+  spi_init();
+#endif
+  sei();
+
+#if BACKGROUND_COMPRESSED
+  progmem_rle_image_sprite_init(&BACKGROUND_SPRITE, BACKGROUND_RLE, 0, 0);
+#else
+  progmem_image_sprite_init(&BACKGROUND_SPRITE, BACKGROUND, 0, 0);
+#endif
+
+  vu_meter_init_all(METERS, METER_CONFIG_INDICES, &(BACKGROUND_SPRITE.sprite));
+  vu_meter_redraw_all(METERS, VU_METERS_N);
+  i2c_wait();
+
+  benchmark_start();
+
+#define BENCH_RUN(id, name, frames_n) bench_run(PSTR(name), bench_ ## id, frames_n);
+
+  while (1) {
+    BENCH_SCENARIOS(BENCH_RUN)
+  }
+}
@@ -2,12 +2,18 @@
 #include <stdbool.h>
 #include <avr/interrupt.h>
 #include <util/atomic.h>
+#include "config.h"
 #include "lcd.h"
 
 
-#define USECONDS_PER_TICK (10)
+/* Timer/Counter1 counts CPU cycles, overflows are accumulated in microseconds,
+ * with remainder in cycles. */
+#define CYCLES_PER_USECOND (F_CPU / 1000000L)
+#define USECONDS_PER_OVERFLOW ((uint16_t) (0x10000L / CYCLES_PER_USECOND))
+#define CYCLES_REMAINDER_PER_OVERFLOW ((uint8_t) (0x10000L % CYCLES_PER_USECOND))
 
-static volatile uint16_t TCNT1_ADD = 0;
+static volatile uint32_t USECONDS_AT_OVERFLOW = 0;
+static volatile uint8_t CYCLES_REMAINDER_AT_OVERFLOW = 0;
 static volatile bool initialized = false;
 
 
@@ -18,43 +24,38 @@ void benchmark_init(void)
   TCCR1B = 0;
   TCCR1C = 0;
   TIMSK1 = 0;
-
-  /* Timer/Counter2: Reset to initial state */
-  TCCR2A = 0;
-  TCCR2B = 0;
-  TIMSK2 = 0;
-
-  /* Timer/Counter2: Mode 7 (Fast PWM) */
-  TCCR2A |= _BV(WGM21) | _BV(WGM20);
-  TCCR2B |= _BV(WGM22);
-  /* Timer/Counter2: TOP = OCR2A = 24 */
-  OCR2A = 24;
-  /* Timer/Counter2: Duty Cycle 50% */
-  OCR2B = 12;
-  /* Timer/Counter2: Clear OC2B on Compare Match, set OC2B at BOTTOM */
-  TCCR2A |= _BV(COM2B1);
-  DDRD |= _BV(PD3);
-  /* Timer/Counter2: Clock Source = CLK/8 */
-  TCCR2B |= _BV(CS21);
+  TCNT1 = 0;
 
   /* Timer/Counter1: Mode 0 (Normal) */
   TCCR1A |= 0;
-  /* Timer/Counter1: Clock Source = T1 Rising Edge */
-  TCCR1B |= _BV(CS12) | _BV(CS11) | _BV(CS10);
+  /* Timer/Counter1: Clock Source = CLK/1 */
+  TCCR1B |= _BV(CS10);
   /* Enable timer overflow interrupt */
   TIMSK1 |= _BV(TOIE1);
+
+  initialized = true;
 }
 
 
 time_t get_current_time(void)
 {
-  time_t result = 0;
+  uint32_t useconds = 0;
+  uint16_t cycles = 0;
+  uint8_t cycles_remainder = 0;
 
   ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
-    result = (time_t) (TCNT1_ADD * 0x10000L + TCNT1) * USECONDS_PER_TICK;
+    cycles = TCNT1;
+    useconds = USECONDS_AT_OVERFLOW;
+    cycles_remainder = CYCLES_REMAINDER_AT_OVERFLOW;
+
+    /* Overflow could have happened after interrupts were disabled */
+    if ((TIFR1 & _BV(TOV1)) && cycles < 0x8000) {
+      useconds += USECONDS_PER_OVERFLOW;
+      cycles_remainder += CYCLES_REMAINDER_PER_OVERFLOW;
+    }
   }
 
-  return result;
+  return useconds + ((uint32_t) cycles + cycles_remainder) / CYCLES_PER_USECOND;
 }
 
 
@@ -75,6 +76,7 @@ time_t benchmark_start(void)
 void
 benchmark_end(char *name, time_t start_time)
 {
+#if LCD_ENABLED
   time_t time = get_current_time() - start_time;
 
   lcd_clear();
@@ -83,10 +85,23 @@ benchmark_end(char *name, time_t start_time)
   lcd_goto(0, 1);
   lcd_put_long(time);
   lcd_puts("us");
+#else
+  (void) name;
+  (void) start_time;
+#endif
 }
 
 
 ISR(TIMER1_OVF_vect)
 {
-  ++TCNT1_ADD;
+  uint8_t cycles_remainder = CYCLES_REMAINDER_AT_OVERFLOW + CYCLES_REMAINDER_PER_OVERFLOW;
+  uint32_t useconds = USECONDS_AT_OVERFLOW + USECONDS_PER_OVERFLOW;
+
+  if (cycles_remainder >= CYCLES_PER_USECOND) {
+    cycles_remainder -= CYCLES_PER_USECOND;
+    ++useconds;
+  }
+
+  CYCLES_REMAINDER_AT_OVERFLOW = cycles_remainder;
+  USECONDS_AT_OVERFLOW = useconds;
 }
@@ -3,7 +3,9 @@
 
 #include <stdint.h>
 
-typedef int32_t time_t;
+/* Microseconds, wrapping around after about 71 minutes. Unsigned, so that
+ * differences of timestamps stay right across the wrap. */
+typedef uint32_t time_t;
 
 
 time_t benchmark_start(void);
@@ -11,6 +13,14 @@ time_t get_current_time(void);
 void benchmark_end(char *name, time_t start_time);
 
 
+/* Signed time from `start` to `end`, for timestamps up to 35 minutes apart */
+static inline int32_t
+time_diff(time_t end, time_t start)
+{
+  return (int32_t) (end - start);
+}
+
+
 #define BENCHMARK(name, ...) \
   do { \
     time_t start = benchmark_start(); \
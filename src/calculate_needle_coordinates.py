@@ -33,10 +33,108 @@ LENGTH = 96
 AXIS_X = DISPLAY_WIDTH / 2
 AXIS_Y = LENGTH
 
+PAGE_HEIGHT = 8
+PAGES_N = DISPLAY_HEIGHT // PAGE_HEIGHT
+NO_COLUMN = -128
+SHADOW_WIDTH = 3
+
+
+def to_int8(value):
+  value &= 0xff
+  return value - 0x100 if value > 0x7f else value
+
+
+def draw_line_23_octants(ax, ay, bx, by):
+  """Same as in firmware, including int8_t arithmetic"""
+  columns = [NO_COLUMN] * DISPLAY_HEIGHT
+  error = 0
+  delta_err = to_int8(abs(bx - ax))
+  error_threshold = to_int8((by - ay) // 2)
+  delta_x = 1 if bx > ax else -1
+  x = ax
+  y = ay
+
+  while y <= by and y < DISPLAY_HEIGHT:
+    columns[y] = to_int8(x)
+    error = to_int8(error + delta_err)
+
+    if error >= error_threshold:
+      x += delta_x
+      error = to_int8(error - error_threshold * 2)
+
+    y += 1
+
+  return columns
+
+
+def page_extents(columns, ax, ay):
+  start_columns = [NO_COLUMN] * PAGES_N
+  end_columns = [NO_COLUMN] * PAGES_N
+  page = ay // PAGE_HEIGHT
+  bottom_x = columns[(page + 1) * PAGE_HEIGHT - 1]
+
+  if ax <= AXIS_X:
+    start_columns[page], end_columns[page] = ax, bottom_x
+  else:
+    start_columns[page], end_columns[page] = bottom_x, ax
+
+  for page in range(page + 1, PAGES_N):
+    top_x = columns[page * PAGE_HEIGHT]
+    bottom_x = columns[(page + 1) * PAGE_HEIGHT - 1]
+    start_columns[page] = min(top_x, bottom_x)
+    end_columns[page] = max(top_x, bottom_x)
+
+  for page in range(PAGES_N):
+    if start_columns[page] == NO_COLUMN:
+      continue
+
+    start_columns[page] = max(start_columns[page] - SHADOW_WIDTH, 0)
+    end_columns[page] = min(end_columns[page] + SHADOW_WIDTH, DISPLAY_WIDTH - 1)
+
+  return start_columns, end_columns
+
+
+coordinates = []
+
 for angle_idx in range(RESOLUTION):
   angle = MIN_ANGLE + (MAX_ANGLE - MIN_ANGLE) * angle_idx / (RESOLUTION - 1)
   ax = int(AXIS_X + math.sin(angle) * LENGTH)
   ay = int(AXIS_Y - math.cos(angle) * LENGTH)
+  coordinates.append((ax, ay))
   print("  { %3d, %3d }," % (ax, ay))
 
+print("};\n")
+
+print("const needle_raster_t NEEDLE_RASTERS[NEEDLE_RESOLUTION] PROGMEM = {")
+
+for ax, ay in coordinates:
+  columns = draw_line_23_octants(ax, ay, int(AXIS_X), int(AXIS_Y))
+  start_columns, end_columns = page_extents(columns, ax, ay)
+  step = 1 if AXIS_X > ax else -1
+  pages = []
+
+  for page in range(PAGES_N):
+    first_row = max(page * PAGE_HEIGHT, ay)
+
+    if start_columns[page] == NO_COLUMN:
+      pages.append("{ %4d, %4d, %4d, 0x00 }" % (NO_COLUMN, NO_COLUMN, NO_COLUMN))
+      continue
+
+    steps = 0
+
+    for row in range(first_row, (page + 1) * PAGE_HEIGHT - 1):
+      if columns[row + 1] != columns[row]:
+        assert columns[row + 1] == columns[row] + step
+        steps |= 1 << (row - page * PAGE_HEIGHT)
+
+    pages.append("{ %4d, %4d, %4d, 0x%02x }" % (
+      start_columns[page], end_columns[page], columns[first_row], steps))
+
+  print("  { %2d, %2d, {" % (ay, step))
+
+  for page in pages:
+    print("    %s," % page)
+
+  print("  } },")
+
 print("};")
@@ -0,0 +1,84 @@
+import sys
+import re
+
+
+def die():
+  print("Usage: calculate_transfer_curve.py <config.h> <scale.rb>")
+  sys.exit(1)
+
+
+if len(sys.argv) != 3:
+  die()
+
+
+def read_define(config, name):
+  match = re.search(r"^#define %s \(([0-9]+)\)" % name, config, re.MULTILINE)
+
+  if match is None:
+    print("%s is not defined in %s" % (name, sys.argv[1]), file=sys.stderr)
+    sys.exit(1)
+
+  return int(match.group(1))
+
+
+with open(sys.argv[1]) as config_file:
+  config = config_file.read()
+
+ADC_FULL_SCALE = read_define(config, "ADC_FULL_SCALE")
+TRANSFER_CURVE_SHIFT = read_define(config, "TRANSFER_CURVE_SHIFT")
+TRANSFER_CURVE_N = 512 >> TRANSFER_CURVE_SHIFT
+MAX_ANGLE = 255
+
+
+# Conversions of images/scale/scale.rb, keep both in sync. Range of the scale
+# is read from there, see read_scale_voltage().
+def dbu_to_v(dbu):
+  return 10 ** (dbu / 20) * 0.6 ** 0.5
+
+def vu_to_v(vu):
+  return dbu_to_v(vu + 4)
+
+
+def read_scale_voltage(scale, name):
+  """Voltage assigned to name in scale.rb, in volts or by one of conversions"""
+  match = re.search(r"^%s = (?:(vu_to_v|dbu_to_v)\(([-+0-9.]+)\)|([0-9.]+))$" % name, scale, re.MULTILINE)
+
+  if match is None:
+    print("%s is not defined in %s" % (name, sys.argv[2]), file=sys.stderr)
+    sys.exit(1)
+
+  if match.group(1) is None:
+    return float(match.group(3))
+
+  return {"vu_to_v": vu_to_v, "dbu_to_v": dbu_to_v}[match.group(1)](float(match.group(2)))
+
+
+with open(sys.argv[2]) as scale_file:
+  scale = scale_file.read()
+
+V_MIN = read_scale_voltage(scale, "V_MIN")
+V_MAX = read_scale_voltage(scale, "V_MAX")
+
+
+# Needle deflection is proportional to the rectified voltage, from V_MIN to
+# V_MAX, with dB marks placed on the face accordingly. ADC full scale is V_MAX.
+def scale_position(v):
+  """Needle position for given voltage, from 0 to 1"""
+  return max(0, (v - V_MIN) / (V_MAX - V_MIN))
+
+
+print("#include \"transfer_curve.h\"")
+print("#include <stdint.h>")
+print("#include <avr/pgmspace.h>\n")
+print("const uint8_t TRANSFER_CURVE[TRANSFER_CURVE_N] PROGMEM = {")
+
+for i in range(0, TRANSFER_CURVE_N, 16):
+  angles = []
+
+  for magnitude in range(i << TRANSFER_CURVE_SHIFT, (i + 16) << TRANSFER_CURVE_SHIFT, 1 << TRANSFER_CURVE_SHIFT):
+    v = V_MAX * magnitude / ADC_FULL_SCALE
+    angles.append(min(MAX_ANGLE, round(MAX_ANGLE * scale_position(v))))
+
+  print("  %s," % ", ".join("%3d" % angle for angle in angles))
+
+print("};")
@@ -3,16 +3,178 @@
 
 #define I2C_DRIVER_ASYNC (0)
 #define I2C_DRIVER_SYNC (1)
+/* Async queue driven by i2c_poll() from the main loop instead of interrupt */
+#define I2C_DRIVER_POLLED (2)
 
+/* Can be set from the command line, `make sim-twi` builds each queue driver */
+#ifndef I2C_DRIVER
 #define I2C_DRIVER I2C_DRIVER_ASYNC
+#endif
 #define I2C_CLOCK (400000L)
-#define I2C_BUFFER_SIZE (64)
-#define I2C_QUEUE_SIZE (4)
+/* Single callback call has to fit, it's a chunk for each display at most */
+#define I2C_BUFFER_SIZE (128)
+/* Longest data run that can be reserved in the buffer, to be written in place */
+#define I2C_RESERVE_MAX (DISPLAY_CHUNK_WIDTH)
+
+/* Hand written TWI interrupt handler for bytes inside of data runs, async
+ * only. Can be set from the command line, `make check` builds it. */
+#ifndef I2C_ASYNC_FAST_ISR
+#define I2C_ASYNC_FAST_ISR (0)
+#endif
+
+/* Displays share TWI bus, or each one has its own SPI port, see spi.h. SPI
+ * takes SCK (PB5) and XCK (PD4), which are LCD_EN and LCD_D7 in lcd.h, and
+ * SPI master takes over MISO (PB4) as input, which is LCD_RS. */
+#define DISPLAY_TRANSPORT_I2C (0)
+#define DISPLAY_TRANSPORT_SPI (1)
+
+#define DISPLAY_TRANSPORT DISPLAY_TRANSPORT_I2C
+
+/* Character LCD can't be used along with SPI, so there are no fault screens,
+ * benchmark results and probe dumps then. Faults still blink port D. */
+#define LCD_ENABLED (DISPLAY_TRANSPORT != DISPLAY_TRANSPORT_SPI)
 
+#if DISPLAY_TRANSPORT == DISPLAY_TRANSPORT_SPI
+#define DISPLAY_A_ADDRESS (0) /* SPI_PORT_SPI */
+#define DISPLAY_B_ADDRESS (1) /* SPI_PORT_USART */
+#else
 #define DISPLAY_A_ADDRESS (0x78)
 #define DISPLAY_B_ADDRESS (0x7A)
+#endif
+
+/* TCA9548A between the bus and displays at given address, so more than two
+ * of them can be used, two on each channel. I2C transport only. Can be set
+ * from the command line, `make sim-twi` builds it. */
+#ifndef I2C_MUX
+#define I2C_MUX (0)
+#endif
+#define I2C_MUX_ADDRESS (0xE0)
+
+/* Meters as display address, mux channel, and ADC channel shown or
+ * VU_METER_SHOWS_FPS. Updates are ordered by channel, see main.c. Each meter
+ * takes a few hundred bytes of RAM, check with `make summary`. */
+#define VU_METER_SHOWS_FPS (0xff)
+
+#if I2C_MUX
+#define VU_METERS(X) \
+  X(DISPLAY_A_ADDRESS, 0, ADC_CHANNEL_L) \
+  X(DISPLAY_B_ADDRESS, 0, ADC_CHANNEL_R) \
+  X(DISPLAY_A_ADDRESS, 1, ADC_CHANNEL_L) \
+  X(DISPLAY_B_ADDRESS, 1, ADC_CHANNEL_R)
+#else
+#define VU_METERS(X) \
+  X(DISPLAY_A_ADDRESS, 0, ADC_CHANNEL_L) \
+  X(DISPLAY_B_ADDRESS, 0, VU_METER_SHOWS_FPS)
+#endif
+
+#define VU_METER_COUNT(address, channel, source) + 1
+#define VU_METERS_N (0 VU_METERS(VU_METER_COUNT))
+
+/* I2C tasks, so update of each meter can be queued at once, power of two */
+#if VU_METERS_N > 4
+#define I2C_QUEUE_SIZE (8)
+#else
+#define I2C_QUEUE_SIZE (4)
+#endif
+
+#if I2C_MUX && DISPLAY_TRANSPORT == DISPLAY_TRANSPORT_SPI
+#error "I2C_MUX needs I2C transport"
+#endif
+
+/* Columns rendered at once, in place into the I2C buffer where possible */
+#define DISPLAY_CHUNK_WIDTH (32)
+
+/* Regions to update kept for each page, before they get merged */
+#define UPDATE_EXTENTS_PAGE_REGIONS (3)
+
+/* Use run length encoded background image, to save flash */
+#define BACKGROUND_COMPRESSED (1)
+
+/* Sprites of each display are known at build time, bottom first, so their
+ * renderers are called directly and inlined, instead of through pointers. */
+#define DISPLAY_STATIC_LAYERS (1)
+
+#if BACKGROUND_COMPRESSED
+#define DISPLAY_BACKGROUND_LAYER(X) X(progmem_rle_image_sprite_render)
+#else
+#define DISPLAY_BACKGROUND_LAYER(X) X(progmem_image_sprite_render)
+#endif
+
+/* Level in dB shown under the scale, on the left. Only cells of characters
+ * that changed are sent. It's the topmost layer, the needle passes behind. */
+#define VU_METER_READOUT (1)
+
+#if VU_METER_READOUT
+#define DISPLAY_READOUT_LAYER(X) X(text_sprite_render)
+#else
+#define DISPLAY_READOUT_LAYER(X)
+#endif
+
+#define DISPLAY_LAYERS(X) \
+  DISPLAY_BACKGROUND_LAYER(X) \
+  X(progmem_image_sprite_render) /* peak indicator */ \
+  X(needle_sprite_render) \
+  DISPLAY_READOUT_LAYER(X)
+
+
+/* ADC inputs of both channels, sampled in background at given rate */
+#define ADC_INPUT_L (2)
+#define ADC_INPUT_R (3)
+#define ADC_SAMPLE_RATE (1000)
+#define ADC_SAMPLES_N (4)
+
+/* Rectified input is measured from zero level, read from EEPROM for each
+ * channel, or ADC_ZERO if not calibrated. Full scale is +3VU. */
+#define ADC_ZERO (498)
+#define ADC_FULL_SCALE (328)
+
+/* Peak is detected on any sample of rectified input getting to the threshold,
+ * +0.5VU, and held at least for hold time. Then it decays by given number
+ * of codes per sample, until it's below the threshold. */
+#define ADC_PEAK_THRESHOLD (247)
+#define ADC_PEAK_HOLD_MS (200)
+#define ADC_PEAK_DECAY (1)
+
+/* Needle angle for every 2^TRANSFER_CURVE_SHIFT ADC codes, generated from the
+ * scale definition by calculate_transfer_curve.py. */
+#define TRANSFER_CURVE_SHIFT (1)
+
+/* Needle ballistics simulated in firmware, for each sample of rectified input.
+ * Defaults are close to VU meter standard, 99% in 300ms with 1.5% overshoot. */
+#define BALLISTICS (1)
+#define BALLISTICS_NATURAL_FREQUENCY (13.1) /* rad/s */
+#define BALLISTICS_DAMPING_RATIO (0.8)
+
+/* Show time of 1000 ballistics steps on the LCD at startup */
+#define BALLISTICS_BENCHMARK (0)
+
+
+/* Measure time spent in parts of the frame, see probe.h, and show it on LCD */
+#define PROBES_ENABLED (0)
+
+/* Set for the benchmark firmware built by `make bench`, see bench.c */
+#ifndef BENCH
+#define BENCH (0)
+#endif
+
+/* Count bytes sent to displays by kind and I2C queue events, see
+ * ssd1306_stats_t and i2c_stats_t */
+#define TRAFFIC_STATS (BENCH)
+
+/* Binary record of each frame sent over UART at given baud rate, see
+ * telemetry.h. USART is used by displays with SPI transport. */
+#define TELEMETRY (0)
+#define TELEMETRY_BAUD (250000)
+#define TELEMETRY_BUFFER_SIZE (64)
+
+/* Frames per second, or 0 to draw as fast as the bus allows */
+#define FRAME_RATE (50)
 
 
+/* Needle is rasterized for 128 positions, see Makefile */
 #define NEEDLE_RESOLUTION (128)
+/* Angle has to get past the boundary of needle position by this much, for
+ * the needle to move by a single position */
+#define NEEDLE_HYSTERESIS (1)
 
 #endif /* CONFIG_H */
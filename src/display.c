@@ -2,8 +2,34 @@
 #include <stdlib.h>
 #include <string.h>
 #include <avr/pgmspace.h>
+#include "i2c.h"
+#include "idle.h"
 #include "utils.h"
 #include "assert.h"
+#include "probe.h"
+
+
+void
+sprite_init(sprite_t *sprite, sprite_render_t render)
+{
+  sprite->render = render;
+  sprite->visible = true;
+  sprite->opaque = false;
+  sprite_set_bounds(sprite, 0, SSD1306_PAGES_N - 1, 0, SSD1306_COLUMNS_N - 1);
+}
+
+
+void
+sprite_set_bounds(sprite_t *sprite, uint8_t start_page, uint8_t end_page, uint8_t start_column, uint8_t end_column)
+{
+  assert(start_page <= end_page && end_page < SSD1306_PAGES_N);
+  assert(start_column <= end_column && end_column < SSD1306_COLUMNS_N);
+
+  sprite->start_page = start_page;
+  sprite->end_page = end_page;
+  sprite->start_column = start_column;
+  sprite->end_column = end_column;
+}
 
 
 void
@@ -11,6 +37,8 @@ display_init(display_t *display, ssd1306_t *device)
 {
   display->device = device;
   display->sprites_n = 0;
+  display->invalidated.empty = true;
+  display->busy = false;
 }
 
 
@@ -23,54 +51,219 @@ display_add_sprite(display_t *display, sprite_t *sprite)
   ++display->sprites_n;
 }
 
-#define SEGMENTS_N (32)
+
+/* Marks area covered by the sprite to be redrawn by next partial update. Has to
+ * be called after changing visibility or content of the sprite, and both
+ * before and after moving it.
+ */
+void
+display_invalidate_sprite(display_t *display, sprite_t *sprite)
+{
+  invalidated_area_t *area = &(display->invalidated);
+
+  if (area->empty) {
+    area->empty = false;
+    area->start_page = sprite->start_page;
+    area->end_page = sprite->end_page;
+    area->start_column = sprite->start_column;
+    area->end_column = sprite->end_column;
+    return;
+  }
+
+  area->start_page = int_min(area->start_page, sprite->start_page);
+  area->end_page = int_max(area->end_page, sprite->end_page);
+  area->start_column = int_min(area->start_column, sprite->start_column);
+  area->end_column = int_max(area->end_column, sprite->end_column);
+}
+
+
+/* Adds one region for each invalidated page */
+void
+display_add_invalidated_to_extents(display_t *display, update_extents_t *extents)
+{
+  invalidated_area_t *area = &(display->invalidated);
+
+  if (area->empty) {
+    return;
+  }
+
+  for (uint8_t page = area->start_page; page <= area->end_page; ++page) {
+    update_extents_add_region(extents, page, area->start_column, area->end_column);
+  }
+
+  area->empty = true;
+}
+
+
+bool
+display_is_invalidated(display_t *display)
+{
+  return !(display->invalidated.empty);
+}
+
+
+#define SEGMENTS_N (DISPLAY_CHUNK_WIDTH)
+
+
+static bool update_extents_find_region(update_extents_t *extents, uint8_t *page, uint8_t *index);
+
+
+static inline bool
+sprite_covers(sprite_t *sprite, uint8_t column_a, uint8_t page, uint8_t column_b)
+{
+  return sprite->visible && sprite->opaque &&
+    page >= sprite->start_page && page <= sprite->end_page &&
+    column_a >= sprite->start_column && column_b <= sprite->end_column;
+}
+
+
+/* Composes the chunk from sprites intersecting it, starting with the topmost
+ * opaque sprite covering it completely. Chunk is cleared if there's none.
+ */
+static void
+display_render_chunk(display_t *display, uint8_t column_a, uint8_t page, uint8_t column_b, ssd1306_segment_t *segments)
+{
+  uint8_t first = display->sprites_n;
+
+  while (first > 0 && !sprite_covers(display->sprites[first - 1], column_a, page, column_b)) {
+    --first;
+  }
+
+  if (first == 0) {
+    memset(segments, 0, column_b - column_a + 1);
+  }
+  else {
+    --first;
+  }
+
+#if DISPLAY_STATIC_LAYERS
+  display_render_layers(display, first, column_a, page, column_b, segments);
+#else
+  for (uint8_t i = first; i < display->sprites_n; ++i) {
+    sprite_t *sprite = display->sprites[i];
+
+    if (sprite_intersects(sprite, column_a, page, column_b)) {
+      sprite->render(sprite, column_a, page, column_b, segments);
+    }
+  }
+#endif
+}
+
+
+static void
+display_start_full_update(display_t *display)
+{
+  assert(!display->busy);
+#if DISPLAY_STATIC_LAYERS
+  display_check_layers(display);
+#endif
+
+  display->busy = true;
+  display->invalidated.empty = true;
+}
+
 
 bool
 display_update_async_cb(display_t *display)
 {
-  ssd1306_segment_t segments[SEGMENTS_N];
-
-  for (uint8_t i = 0; i < display->sprites_n; ++i) {
-    if (display->sprites[i]->visible) {
-      display->sprites[i]->render(
-        display->sprites[i],
-        display->update.full.column,
-        display->update.full.page,
-        display->update.full.column + SEGMENTS_N - 1,
-        segments
-      );
+  full_update_ctrl_t *update = &(display->update.full);
+
+  /* Displays are configured in the same transaction right before the first
+   * chunk, one for each call */
+  if (ssd1306_send_init_sequence(display->device)) {
+    return true;
+  }
+
+  for (uint8_t i = 0; i < update->others_n; ++i) {
+    if (ssd1306_send_init_sequence(update->others[i]->device)) {
+      return true;
     }
   }
 
-  ssd1306_put_segments(
-    display->device,
-    display->update.full.column,
-    display->update.full.page,
-    SEGMENTS_N,
-    segments
-  );
+  /* Chunks are produced until the buffer is full, the last one as wide as
+   * still fits. Chunk is put to each display, so it takes a share of each. */
+  uint8_t puts_n = 1 + update->others_n;
+  bool produced = false;
 
-  display->update.full.column += SEGMENTS_N;
+  do {
+    uint8_t width = int_min(SSD1306_COLUMNS_N - update->column, SEGMENTS_N);
+    width = int_min(width, ssd1306_capacity(puts_n) / puts_n);
 
-  if (display->update.full.column >= SSD1306_COLUMNS_N) {
-    display->update.full.column = 0;
-    ++display->update.full.page;
+    if (width == 0) {
+      assert(produced);
+      return true;
+    }
 
-    if (display->update.full.page >= SSD1306_PAGES_N) {
-      ssd1306_finish_update(display->device);
-      return false;
+    ssd1306_segment_t *segments = ssd1306_reserve_segments(
+      display->device,
+      update->column,
+      update->page,
+      width
+    );
+
+    PROBE(RENDER_CHUNK, display_render_chunk(
+      display,
+      update->column,
+      update->page,
+      update->column + width - 1,
+      segments
+    ));
+
+    ssd1306_commit_segments(display->device, width);
+
+    /* Each display takes over the bus with repeated START, and gets a copy of
+     * segments already in the buffer */
+    for (uint8_t i = 0; i < update->others_n; ++i) {
+      ssd1306_put_segments(update->others[i]->device, update->column, update->page, width, segments);
     }
+
+    produced = true;
+    update->column += width;
+
+    if (update->column >= SSD1306_COLUMNS_N) {
+      update->column = 0;
+      ++update->page;
+    }
+  } while (update->page < SSD1306_PAGES_N);
+
+  ssd1306_finish_update(display->device);
+  display->busy = false;
+
+  for (uint8_t i = 0; i < update->others_n; ++i) {
+    ssd1306_finish_update(update->others[i]->device);
+    update->others[i]->busy = false;
   }
 
-  return true;
+  return false;
 }
 
 
 void
 display_update_async(display_t *display)
 {
+  display_update_multicast_async(display, NULL, 0);
+}
+
+
+/* Updates other displays, with the same content as the first one, during
+ * a single I2C transaction. Sprites are composed only once for all of them, so
+ * it's meant for displays showing exactly the same, e.g. right after startup.
+ * All of them have to be on the same mux channel.
+ */
+void
+display_update_multicast_async(display_t *display, display_t * const *others, uint8_t others_n)
+{
+  display_start_full_update(display);
+
+  for (uint8_t i = 0; i < others_n; ++i) {
+    assert(others[i]->device->channel == display->device->channel);
+    display_start_full_update(others[i]);
+  }
+
   display->update.full.column = 0;
   display->update.full.page = 0;
+  display->update.full.others = others;
+  display->update.full.others_n = others_n;
 
   ssd1306_start_update(
     display->device,
@@ -83,56 +276,83 @@ display_update_async(display_t *display)
 bool
 display_update_partial_async_cb(display_t *display)
 {
-  ssd1306_segment_t segments[SEGMENTS_N];
   partial_update_ctrl_t *update = &(display->update.partial);
-  region_t *region = &(update->extents->regions[update->region_index]);
-
-  uint8_t column_b = int_min(update->column + SEGMENTS_N - 1, region->end_column);
-
-  for (uint8_t i = 0; i < display->sprites_n; ++i) {
-    if (display->sprites[i]->visible) {
-      display->sprites[i]->render(
-        display->sprites[i],
-        update->column,
-        region->page,
-        column_b,
-        segments
-      );
+  bool advanced = false;
+
+  /* Chunks are advanced until the buffer is full, going on across regions,
+   * and the last one is cut to what still fits. */
+  do {
+    region_t *region = &(update->extents->regions[update->region_page][update->region_index]);
+    uint8_t column_b = int_min(update->column + SEGMENTS_N - 1, region->end_column);
+    uint8_t capacity = ssd1306_capacity(1);
+
+    if (capacity == 0) {
+      assert(advanced);
+      return true;
     }
-  }
 
-  ssd1306_put_segments(
-    display->device,
-    update->column,
-    region->page,
-    column_b - update->column + 1,
-    segments
-  );
+    column_b = int_min(column_b, update->column + capacity - 1);
+
+    if (region->end_page != region->page && update->page == region->page &&
+      update->column == region->start_column)
+    {
+      ssd1306_set_window(display->device, region->start_column, region->end_column, region->page, region->end_page);
+    }
+
+    uint8_t width = column_b - update->column + 1;
+    ssd1306_segment_t *segments = ssd1306_reserve_segments(display->device, update->column, update->page, width);
+
+    PROBE(RENDER_CHUNK, display_render_chunk(display, update->column, update->page, column_b, segments));
+
+    ssd1306_commit_segments(display->device, width);
 
-  if (column_b == region->end_column) {
-    ++(update->region_index);
+    advanced = true;
 
-    if (update->region_index == update->extents->regions_n) {
-      ssd1306_finish_update(display->device);
-      return false;
+    if (column_b != region->end_column) {
+      update->column = column_b + 1;
     }
+    else if (update->page != region->end_page) {
+      ++(update->page);
+      update->column = region->start_column;
+    }
+    else {
+      ++(update->region_index);
 
-    update->column = update->extents->regions[update->region_index].start_column;
-  }
-  else {
-    update->column = column_b + 1;
-  }
+      if (!update_extents_find_region(update->extents, &(update->region_page), &(update->region_index))) {
+        ssd1306_finish_update(display->device);
+        display->busy = false;
+        return false;
+      }
 
-  return true;
+      region = &(update->extents->regions[update->region_page][update->region_index]);
+      update->page = region->page;
+      update->column = region->start_column;
+    }
+  } while (true);
 }
 
 
 void
 display_update_partial_async(display_t *display, update_extents_t *extents)
 {
-  display->update.partial.region_index = 0;
-  display->update.partial.column = extents->regions[0].start_column;
-  display->update.partial.extents = extents;
+  assert(!display->busy);
+  assert(!display->device->init_pending); /* only full update sends it */
+
+  partial_update_ctrl_t *update = &(display->update.partial);
+
+  update->region_page = 0;
+  update->region_index = 0;
+
+  if (!update_extents_find_region(extents, &(update->region_page), &(update->region_index))) {
+    return;
+  }
+
+  region_t *region = &(extents->regions[update->region_page][update->region_index]);
+
+  update->page = region->page;
+  update->column = region->start_column;
+  update->extents = extents;
+  display->busy = true;
 
   ssd1306_start_update(
     display->device,
@@ -142,103 +362,153 @@ display_update_partial_async(display_t *display, update_extents_t *extents)
 }
 
 
+bool
+display_is_busy(display_t *display)
+{
+  return display->busy;
+}
+
+
 void
-update_extents_reset(update_extents_t *extents)
+display_wait(display_t *display)
 {
-  extents->regions_n = 0;
+  cli();
+
+  while (display_is_busy(display)) {
+    idle_wait();
+    cli();
+  }
+
+  sei();
 }
 
 
 void
-update_extents_add_region(update_extents_t *extents, uint8_t page, uint8_t start_column, uint8_t end_column)
+update_extents_reset(update_extents_t *extents)
+{
+  memset(extents->regions_n, 0, sizeof(extents->regions_n));
+}
+
+
+/* Sending the gap is cheaper than moving the cursor to the next region */
+static inline bool
+can_merge_regions(const region_t *region_a, uint8_t start_column)
 {
-  extents->regions[extents->regions_n].page = page;
-  extents->regions[extents->regions_n].start_column = start_column;
-  extents->regions[extents->regions_n].end_column = end_column;
-  ++(extents->regions_n);
+  return start_column <= region_a->end_column + 1 + ssd1306_reposition_cost(SSD1306_I2C_MODE_DATA, false);
 }
 
 
-static int
-cmp_regions_by_page_and_column(const void *a, const void *b)
+/* Region is merged with its neighbours on the page, when it's cheaper. If the
+ * page is full, it's merged with the closest one anyway.
+ */
+void
+update_extents_add_region(update_extents_t *extents, uint8_t page, uint8_t start_column, uint8_t end_column)
 {
-  region_t *region_a = (region_t *) a;
-  region_t *region_b = (region_t *) b;
+  assert(start_column <= end_column);
 
-  if (region_a->page > region_b->page) {
-    return 1;
+  region_t *regions = extents->regions[page];
+  uint8_t regions_n = extents->regions_n[page];
+  uint8_t i = 0;
+
+  while (i < regions_n && regions[i].start_column <= start_column) {
+    ++i;
   }
-  else if (region_a->page < region_b->page) {
-    return -1;
+
+  if (i > 0 && can_merge_regions(&(regions[i - 1]), start_column)) {
+    --i;
+    regions[i].end_column = int_max(regions[i].end_column, end_column);
+  }
+  else if (regions_n == UPDATE_EXTENTS_PAGE_REGIONS) {
+    if (i == regions_n || (i > 0 &&
+      start_column - regions[i - 1].end_column < regions[i].start_column - end_column))
+    {
+      --i;
+    }
+
+    regions[i].start_column = int_min(regions[i].start_column, start_column);
+    regions[i].end_column = int_max(regions[i].end_column, end_column);
   }
   else {
-    return ((region_a->start_column > region_b->start_column) -
-      (region_a->start_column < region_b->start_column));
+    memmove(&(regions[i + 1]), &(regions[i]), (regions_n - i) * sizeof(region_t));
+    regions[i].page = page;
+    regions[i].end_page = page;
+    regions[i].start_column = start_column;
+    regions[i].end_column = end_column;
+    ++regions_n;
   }
-}
 
+  /* Region could have grown over the following ones */
+  while (i + 1 < regions_n && can_merge_regions(&(regions[i]), regions[i + 1].start_column)) {
+    regions[i].end_column = int_max(regions[i].end_column, regions[i + 1].end_column);
+    memmove(&(regions[i + 1]), &(regions[i + 2]), (regions_n - i - 2) * sizeof(region_t));
+    --regions_n;
+  }
 
-static bool
-can_merge_regions(const region_t *region_a, const region_t *region_b)
-{
-  /* If regions were not merged additional 8 bytes would need to be sent to
-   * reposition the cursor.
-   */
-  return (region_a->page == region_b->page)
-    && (region_b->start_column <= region_a->end_column + 1 + 8);
+  extents->regions_n[page] = regions_n;
 }
 
 
-static void
-merge_regions(const region_t *source_a, const region_t *source_b, region_t *target)
+/* Region is added as the next page of a multipage region, if sending the
+ * columns they don't share is cheaper than setting up a separate region.
+ */
+static bool
+can_combine_regions(const region_t *region_a, const region_t *region_b)
 {
-  target->page = source_a->page;
-  target->start_column = source_a->start_column;
-  target->end_column = int_max(source_a->end_column, source_b->end_column);
+  uint16_t width_a = region_a->end_column - region_a->start_column + 1;
+  uint16_t width_b = region_b->end_column - region_b->start_column + 1;
+  uint16_t width = int_max(region_a->end_column, region_b->end_column) -
+    int_min(region_a->start_column, region_b->start_column) + 1;
+  uint16_t pages_n = region_a->end_page - region_a->page + 1;
+
+  return width * (pages_n + 1) <=
+    width_a * pages_n + width_b + ssd1306_reposition_cost(SSD1306_I2C_MODE_DATA, true);
 }
 
 
 static void
-copy_region(const region_t *source, region_t *target)
+combine_regions(region_t *target, const region_t *source)
 {
-  memcpy(target, source, sizeof(region_t));
+  target->end_page = source->page;
+  target->start_column = int_min(target->start_column, source->start_column);
+  target->end_column = int_max(target->end_column, source->end_column);
 }
 
 
+/* Has to be called after all regions were added. Only regions alone on their
+ * pages are combined.
+ */
 void
-update_extents_optimize(update_extents_t *extents)
+update_extents_combine_pages(update_extents_t *extents)
 {
-  qsort(extents->regions, extents->regions_n, sizeof(region_t),
-    cmp_regions_by_page_and_column);
-
-  region_t *regions = extents->regions;
+  region_t *target = NULL;
 
-  uint8_t source_a_idx = 0;
-  uint8_t source_b_idx = 0;
-  uint8_t target_idx = 0;
-
-  for (source_a_idx = 0; source_a_idx < extents->regions_n; ++target_idx) {
-    region_t *source_a = &(regions[source_a_idx]);
-    region_t *target = &(regions[target_idx]);
+  for (uint8_t page = 0; page < SSD1306_PAGES_N; ++page) {
+    if (extents->regions_n[page] != 1) {
+      target = NULL;
+      continue;
+    }
 
-    for (source_b_idx = source_a_idx + 1; source_b_idx < extents->regions_n; ++source_b_idx)
-    {
-      region_t *source_b = &(regions[source_b_idx]);
+    region_t *region = &(extents->regions[page][0]);
 
-      if (can_merge_regions(source_a, source_b)) {
-        merge_regions(source_a, source_b, target);
-      }
-      else {
-        break;
-      }
+    if (target && can_combine_regions(target, region)) {
+      combine_regions(target, region);
+      extents->regions_n[page] = 0;
     }
-
-    if ((source_b_idx == source_a_idx + 1) && (target_idx != source_a_idx)) {
-      copy_region(source_a, target);
+    else {
+      target = region;
     }
+  }
+}
+
 
-    source_a_idx = source_b_idx;
+/* Finds the first region at or after given position, skipping empty pages */
+static bool
+update_extents_find_region(update_extents_t *extents, uint8_t *page, uint8_t *index)
+{
+  while (*page < SSD1306_PAGES_N && *index >= extents->regions_n[*page]) {
+    ++(*page);
+    *index = 0;
   }
 
-  extents->regions_n = target_idx;
+  return *page < SSD1306_PAGES_N;
 }
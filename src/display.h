@@ -12,33 +12,54 @@ typedef struct sprite_t_ sprite_t;
 
 typedef void (*sprite_render_t)(sprite_t *sprite, uint8_t column_a, uint8_t page, uint8_t column_b, ssd1306_segment_t* segments);
 
+/* Sprite is rendered only for chunks intersecting its bounds. Opaque sprite
+ * overwrites every segment inside of its bounds, so sprites below it don't
+ * have to be rendered at all.
+ */
 struct sprite_t_ {
   sprite_render_t render;
   bool visible;
+  bool opaque;
+  uint8_t start_page;
+  uint8_t end_page;
+  uint8_t start_column;
+  uint8_t end_column;
 };
 
 
+/* Regions spanning several pages are sent as a single stream, inside of
+ * a window set to their columns */
 typedef struct region_t_ {
   uint8_t page;
+  uint8_t end_page;
   uint8_t start_column;
   uint8_t end_column;
 } region_t;
 
+/* Regions of each page are kept sorted by column and merged, whenever sending
+ * the gap between them is cheaper than moving the cursor. Multipage region is
+ * kept with its first page, pages it covers are left empty.
+ */
 typedef struct update_extents_t_ {
-  uint8_t regions_n;
-  region_t *regions;
+  uint8_t regions_n[SSD1306_PAGES_N];
+  region_t regions[SSD1306_PAGES_N][UPDATE_EXTENTS_PAGE_REGIONS];
 } update_extents_t;
 
 typedef struct partial_update_ctrl_t_ {
+  uint8_t region_page;
   uint8_t region_index;
+  uint8_t page;
   uint8_t column;
   update_extents_t *extents;
 } partial_update_ctrl_t;
 
 
+/* Chunks rendered once are also sent to other displays, if any */
 typedef struct full_update_ctrl_t_ {
   uint8_t page;
   uint8_t column;
+  uint8_t others_n;
+  struct display_t_ * const *others;
 } full_update_ctrl_t;
 
 
@@ -48,21 +69,92 @@ typedef union update_ctrl_t_ {
 } update_ctrl_t;
 
 
+/* Bounding box of everything invalidated since the last partial update */
+typedef struct invalidated_area_t_ {
+  bool empty;
+  uint8_t start_page;
+  uint8_t end_page;
+  uint8_t start_column;
+  uint8_t end_column;
+} invalidated_area_t;
+
+
 typedef struct display_t_ {
   ssd1306_t *device;
   sprite_t *sprites[DISPLAY_MAX_SPRITES];
   uint8_t sprites_n;
   update_ctrl_t update;
+  invalidated_area_t invalidated;
+  volatile bool busy;
 } display_t;
 
 
+void sprite_init(sprite_t *sprite, sprite_render_t render);
+void sprite_set_bounds(sprite_t *sprite, uint8_t start_page, uint8_t end_page, uint8_t start_column, uint8_t end_column);
+
 void display_init(display_t *display, ssd1306_t *device);
 void display_add_sprite(display_t *display, sprite_t *sprite);
+void display_invalidate_sprite(display_t *display, sprite_t *sprite);
+void display_add_invalidated_to_extents(display_t *display, update_extents_t *extents);
+bool display_is_invalidated(display_t *display);
 void display_update_async(display_t *display);
+void display_update_multicast_async(display_t *display, display_t * const *others, uint8_t others_n);
 void display_update_partial_async(display_t *display, update_extents_t *extents);
+bool display_is_busy(display_t *display);
+void display_wait(display_t *display);
+
+
+static inline bool
+sprite_intersects(sprite_t *sprite, uint8_t column_a, uint8_t page, uint8_t column_b)
+{
+  return sprite->visible &&
+    page >= sprite->start_page && page <= sprite->end_page &&
+    column_b >= sprite->start_column && column_a <= sprite->end_column;
+}
+
+
+#if DISPLAY_STATIC_LAYERS
+/* Sprites are still added with display_add_sprite(), but each one is rendered
+ * by the function at its place in DISPLAY_LAYERS(). Both functions below are
+ * defined by DISPLAY_DEFINE_LAYERS, where all of the renderers are visible.
+ */
+void display_check_layers(display_t *display);
+void display_render_layers(display_t *display, uint8_t first, uint8_t column_a, uint8_t page,
+                           uint8_t column_b, ssd1306_segment_t *segments);
+
+#define DISPLAY_CHECK_LAYER(renderer) \
+  assert(display->sprites[layer]->render == (renderer)); \
+  ++layer;
+
+#define DISPLAY_RENDER_LAYER(renderer) \
+  if (layer >= first && sprite_intersects(display->sprites[layer], column_a, page, column_b)) { \
+    renderer(display->sprites[layer], column_a, page, column_b, segments); \
+  } \
+  ++layer;
+
+#define DISPLAY_COUNT_LAYER(renderer) + 1
+
+#define DISPLAY_DEFINE_LAYERS \
+  void \
+  display_check_layers(display_t *display) \
+  { \
+    uint8_t layer = 0; \
+    assert(display->sprites_n == 0 DISPLAY_LAYERS(DISPLAY_COUNT_LAYER)); \
+    DISPLAY_LAYERS(DISPLAY_CHECK_LAYER) \
+    (void) layer; \
+  } \
+  \
+  void \
+  display_render_layers(display_t *display, uint8_t first, uint8_t column_a, uint8_t page, \
+                        uint8_t column_b, ssd1306_segment_t *segments) \
+  { \
+    uint8_t layer = 0; \
+    DISPLAY_LAYERS(DISPLAY_RENDER_LAYER) \
+  }
+#endif
 
 void update_extents_reset(update_extents_t *extents);
 void update_extents_add_region(update_extents_t *extents, uint8_t page, uint8_t start_column, uint8_t end_column);
-void update_extents_optimize(update_extents_t *extents);
+void update_extents_combine_pages(update_extents_t *extents);
 
 #endif /* DISPLAY_H */
@@ -3,6 +3,7 @@
 #include <avr/io.h>
 #include <avr/interrupt.h>
 #include <util/delay.h>
+#include "config.h"
 #include "lcd.h"
 
 
@@ -11,6 +12,7 @@ lcd_fault(fault_code_t code, uint16_t extended_status, const char *error_text)
 {
   cli();
 
+#if LCD_ENABLED
   lcd_init();
   lcd_puts("F: ");
 
@@ -23,11 +25,16 @@ lcd_fault(fault_code_t code, uint16_t extended_status, const char *error_text)
   lcd_put_int(extended_status);
 
   int text_len = strlen(error_text);
+#else
+  (void) code;
+  (void) extended_status;
+#endif
 
   TWCR = 0;
   DDRD = 0xff;
   PORTD = 0x00;
 
+#if LCD_ENABLED
   if (error_text == NULL) {
     lcd_goto(0, 1);
     lcd_puts("No error text");
@@ -55,4 +62,12 @@ lcd_fault(fault_code_t code, uint16_t extended_status, const char *error_text)
     PORTD = ~PORTD;
     _delay_ms(1000);
   }
+#else
+  (void) error_text;
+
+  while (1) {
+    PORTD = ~PORTD;
+    _delay_ms(500);
+  }
+#endif
 }
@@ -3,6 +3,6 @@
 
 #if I2C_DRIVER == I2C_DRIVER_SYNC
 #include "i2c_sync.c"
-#elif I2C_DRIVER == I2C_DRIVER_ASYNC
+#elif I2C_DRIVER == I2C_DRIVER_ASYNC || I2C_DRIVER == I2C_DRIVER_POLLED
 #include "i2c_async.c"
 #endif
@@ -9,18 +9,42 @@
 
 typedef bool (*i2c_callback_t)(void *data);
 
+/* Events of the async queue since the last reset. Stall means transmitter
+ * ran out of commands before producer filled the other buffer. Mux switch is
+ * a transaction of its own, selecting another channel of I2C_MUX. */
+typedef struct i2c_stats_t_ {
+  uint16_t buffer_switches;
+  uint16_t pending_stalls;
+  uint16_t mux_switches;
+} i2c_stats_t;
+
 
 void i2c_init(void);
 
-void i2c_transmit_async(uint8_t address, i2c_callback_t callback, void *data);
+/* All devices task sends to have to be on its mux channel, 0 without I2C_MUX */
+void i2c_transmit_async(uint8_t channel, uint8_t address, i2c_callback_t callback, void *data);
 void i2c_async_send_byte(uint8_t data);
 void i2c_async_send_bytes(uint8_t *data, uint8_t n);
+uint8_t *i2c_async_reserve_bytes(uint8_t n);
+void i2c_async_commit_bytes(uint8_t n);
+uint8_t i2c_async_capacity(void);
 void i2c_async_send_start(void);
+void i2c_async_send_start_to(uint8_t address);
 void i2c_async_end_transmission(void);
 bool i2c_is_idle(void);
 void i2c_wait(void);
 
-void i2c_transmit_progmem(uint8_t address, const uint8_t *data, uint16_t length);
+/* Has to be called whenever waiting for the bus, with polled driver */
+#if I2C_DRIVER == I2C_DRIVER_POLLED
+void i2c_poll(void);
+#else
+#define i2c_poll() do { } while (0)
+#endif
+
+#if TRAFFIC_STATS
+i2c_stats_t i2c_get_stats(void);
+void i2c_reset_stats(void);
+#endif
 
 
 #endif /* I2C_H */
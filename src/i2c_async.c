@@ -1,15 +1,18 @@
 #include "i2c.h"
 #include <stdlib.h>
+#include <string.h>
 #include <avr/io.h>
 #include <avr/interrupt.h>
-#include <avr/pgmspace.h>
 #include <util/atomic.h>
 #include <util/twi.h>
 #include "config.h"
+#include "utils.h"
 #include "fault.h"
 #include "assert.h"
 #include "ring_buffer.h"
 #include "i2c_hw.h"
+#include "probe.h"
+#include "idle.h"
 
 
 typedef enum i2c_command_code_t_ {
@@ -20,28 +23,53 @@ typedef enum i2c_command_code_t_ {
 } i2c_command_code_t;
 
 
-typedef struct i2c_command_t_ {
-  i2c_command_code_t code;
-  uint8_t data;
-} i2c_command_t;
+/* Commands are packed into the buffer as variable length records. START record
+ * is followed by the address byte and STOP record has no payload. Header with
+ * I2C_RECORD_DATA_RUN bit set is followed by a run of data bytes, with run
+ * length stored in lower bits of the header.
+ */
+#define I2C_RECORD_DATA_RUN (0x80)
+#define I2C_RECORD_RUN_LENGTH_MASK (0x7f)
+#define I2C_RECORD_MAX_RUN_LENGTH (I2C_RECORD_RUN_LENGTH_MASK)
+
+#define I2C_NO_OPEN_RUN (0xff)
+
+#if I2C_BUFFER_SIZE >= I2C_NO_OPEN_RUN
+#error "I2C_BUFFER_SIZE is too big to be indexed"
+#endif
+
+#if I2C_RESERVE_MAX > I2C_RECORD_MAX_RUN_LENGTH
+#error "I2C_RESERVE_MAX doesn't fit into single data run"
+#endif
+
+/* Mux takes the channel mask when STOP ends the write to it, so it's a
+ * transaction of its own: START, address, one byte data run, STOP. */
+#define I2C_MUX_SWITCH_SIZE (5)
+#define I2C_MUX_NO_CHANNEL (0xff)
 
 
 typedef struct i2c_command_buffer_t_ {
   uint8_t length;
-  i2c_command_t commands[I2C_BUFFER_SIZE];
+  uint8_t open_run; /* index of data run header that can still be extended */
+  uint8_t records[I2C_BUFFER_SIZE];
 } i2c_command_buffer_t;
 
 
 typedef struct i2c_task_t_ {
   i2c_callback_t callback;
   void *data;
-  uint8_t address; /* TODO: remove */
+  uint8_t address; /* default for START, other devices can be addressed too */
+#if I2C_MUX
+  uint8_t channel; /* of all devices addressed */
+#endif
 } i2c_task_t;
 
 
+RING_BUFFER_DEFINE(i2c_tasks, i2c_task_t, I2C_QUEUE_SIZE)
+
+
 typedef struct i2c_queue_t_ {
-  i2c_task_t tasks_storage[I2C_QUEUE_SIZE];
-  ring_buffer_t tasks;
+  i2c_tasks_t tasks;
 
   i2c_command_buffer_t buffer_a;
   i2c_command_buffer_t buffer_b;
@@ -51,10 +79,17 @@ typedef struct i2c_queue_t_ {
 
   bool transmitter_active;
   bool pending_buffer_switch;
-  uint8_t tasks_n;
 
-  uint8_t front_buffer_cursor;
-  i2c_command_t current_command;
+  const uint8_t *front_buffer_cursor;
+  const uint8_t *front_buffer_end;
+  i2c_command_code_t current_command;
+  uint8_t run_remaining; /* non-zero only while current command is SEND_DATA */
+#if I2C_MUX
+  uint8_t mux_channel; /* selected once back buffer is sent */
+#endif
+#if TRAFFIC_STATS
+  i2c_stats_t stats;
+#endif
 } i2c_queue_t;
 
 
@@ -63,15 +98,51 @@ static i2c_queue_t I2C_QUEUE;
 
 #define assert_interrupts_disabled() assert((SREG & _BV(SREG_I)) == 0)
 
+#if I2C_DRIVER == I2C_DRIVER_POLLED
+#if I2C_ASYNC_FAST_ISR
+#error "I2C_ASYNC_FAST_ISR needs interrupt driven driver"
+#endif
+
+/* TWINT is checked by i2c_poll(), interrupt stays disabled */
+#define i2c_hw_send_byte_next(octet) i2c_hw_send_byte(octet)
+#define i2c_hw_send_start_condition_next() i2c_hw_send_start_condition()
+#else
+#define i2c_hw_send_byte_next(octet) i2c_hw_send_byte_int(octet)
+#define i2c_hw_send_start_condition_next() i2c_hw_send_start_condition_int()
+#endif
+
+#if TRAFFIC_STATS
+#define i2c_count(counter) (++(I2C_QUEUE.stats.counter))
+#else
+#define i2c_count(counter) do { } while (0)
+#endif
+
 
 static void i2c_queue_process_command(void);
 
 
+static inline void
+i2c_queue_load_record(void)
+{
+  uint8_t header = *(I2C_QUEUE.front_buffer_cursor);
+  ++I2C_QUEUE.front_buffer_cursor;
+
+  if (header & I2C_RECORD_DATA_RUN) {
+    I2C_QUEUE.current_command = I2C_COMMAND_SEND_DATA;
+    I2C_QUEUE.run_remaining = header & I2C_RECORD_RUN_LENGTH_MASK;
+    assert(I2C_QUEUE.run_remaining > 0);
+  }
+  else {
+    I2C_QUEUE.current_command = (i2c_command_code_t) header;
+  }
+}
+
+
 static void
 i2c_queue_switch_buffers()
 {
   assert(I2C_QUEUE.back_buffer->length > 0);
-  assert(I2C_QUEUE.front_buffer_cursor == I2C_QUEUE.front_buffer->length);
+  assert(I2C_QUEUE.front_buffer_cursor == I2C_QUEUE.front_buffer_end);
 
   i2c_command_buffer_t *tmp = I2C_QUEUE.back_buffer;
   I2C_QUEUE.back_buffer = I2C_QUEUE.front_buffer;
@@ -79,9 +150,13 @@ i2c_queue_switch_buffers()
 
   I2C_QUEUE.pending_buffer_switch = false;
   I2C_QUEUE.back_buffer->length = 0;
-  I2C_QUEUE.front_buffer_cursor = 0;
+  I2C_QUEUE.back_buffer->open_run = I2C_NO_OPEN_RUN;
+  i2c_count(buffer_switches);
+
+  I2C_QUEUE.front_buffer_cursor = I2C_QUEUE.front_buffer->records;
+  I2C_QUEUE.front_buffer_end = I2C_QUEUE.front_buffer->records + I2C_QUEUE.front_buffer->length;
 
-  I2C_QUEUE.current_command = I2C_QUEUE.front_buffer->commands[0];
+  i2c_queue_load_record();
 }
 
 
@@ -89,17 +164,14 @@ static void
 i2c_queue_switch_tasks(void)
 {
   assert_interrupts_disabled();
-  ring_buffer_assert_can_read_n_elements(&(I2C_QUEUE.tasks), 1);
-
-  ring_buffer_discard(&(I2C_QUEUE.tasks));
-  --I2C_QUEUE.tasks_n;
+  i2c_tasks_discard(&(I2C_QUEUE.tasks));
 }
 
 
 static inline void i2c_queue_start_transmitter(void)
 {
   assert(!(I2C_QUEUE.transmitter_active));
-  assert(I2C_QUEUE.current_command.code != I2C_COMMAND_PENDING);
+  assert(I2C_QUEUE.current_command != I2C_COMMAND_PENDING);
 
   I2C_QUEUE.transmitter_active = true;
   i2c_queue_process_command();
@@ -110,15 +182,15 @@ static void
 i2c_queue_fetch_commands(void)
 {
   assert_interrupts_disabled();
-  assert(I2C_QUEUE.tasks_n > 0);
+  assert(!i2c_tasks_is_empty(&(I2C_QUEUE.tasks)));
   assert(!(I2C_QUEUE.pending_buffer_switch));
 
   do {
-    if (I2C_QUEUE.tasks_n == 0) {
+    if (i2c_tasks_is_empty(&(I2C_QUEUE.tasks))) {
       return;
     }
 
-    i2c_task_t *task = (i2c_task_t *) ring_buffer_get_first(&(I2C_QUEUE.tasks));
+    i2c_task_t *task = i2c_tasks_get_first(&(I2C_QUEUE.tasks));
 
     assert(I2C_QUEUE.back_buffer->length == 0);
 
@@ -128,12 +200,15 @@ i2c_queue_fetch_commands(void)
       keep_task = task->callback(task->data);
     }
 
-    assert(I2C_QUEUE.back_buffer->length > 0);
-
     if (!keep_task) {
       i2c_queue_switch_tasks();
     }
 
+    if (I2C_QUEUE.back_buffer->length == 0) {
+      /* Producer had nothing to send */
+      continue;
+    }
+
     if (!I2C_QUEUE.transmitter_active) {
       /* Other buffer was sent in full, we start processing next command and
        * proceed to produce more commands immediately. */
@@ -156,17 +231,29 @@ i2c_queue_process_command(void)
   assert(I2C_QUEUE.transmitter_active);
 
   assert(I2C_QUEUE.front_buffer->length > 0);
-  assert(I2C_QUEUE.front_buffer_cursor <= I2C_QUEUE.front_buffer->length);
+  assert(I2C_QUEUE.front_buffer_cursor <= I2C_QUEUE.front_buffer_end);
 
-  switch (I2C_QUEUE.current_command.code) {
+  switch (I2C_QUEUE.current_command) {
 
     case I2C_COMMAND_SEND_DATA:
-      i2c_hw_send_byte_int(I2C_QUEUE.current_command.data);
+      i2c_hw_send_byte_next(*(I2C_QUEUE.front_buffer_cursor));
+      ++I2C_QUEUE.front_buffer_cursor;
+      --I2C_QUEUE.run_remaining;
+
+      if (I2C_QUEUE.run_remaining > 0) {
+        /* Next byte is in the same data run, nothing more to do */
+        return;
+      }
+
       break;
 
     case I2C_COMMAND_START:
-      i2c_hw_send_start_condition_int();
-      break;
+      i2c_hw_send_start_condition_next();
+
+      /* Address byte following START record is sent as one byte data run */
+      I2C_QUEUE.current_command = I2C_COMMAND_SEND_DATA;
+      I2C_QUEUE.run_remaining = 1;
+      return;
 
     case I2C_COMMAND_STOP:
       i2c_hw_send_stop_condition();
@@ -180,12 +267,13 @@ i2c_queue_process_command(void)
         i2c_queue_switch_buffers();
         i2c_queue_process_command();
 
-        if (I2C_QUEUE.tasks_n > 0) {
+        if (!i2c_tasks_is_empty(&(I2C_QUEUE.tasks))) {
           i2c_queue_fetch_commands();
         }
       }
       else {
         /* No more data waiting - disable transmitter interrupt and exit */
+        i2c_count(pending_stalls);
         i2c_hw_disable_int();
         I2C_QUEUE.transmitter_active = false;
       }
@@ -193,13 +281,11 @@ i2c_queue_process_command(void)
       return;
 
     default:
-      fault(FAULT_I2C, I2C_QUEUE.current_command.code, "Invalid command");
+      fault(FAULT_I2C, I2C_QUEUE.current_command, "Invalid command");
       break;
   }
 
-  ++I2C_QUEUE.front_buffer_cursor;
-
-  if (I2C_QUEUE.front_buffer_cursor == I2C_QUEUE.front_buffer->length) {
+  if (I2C_QUEUE.front_buffer_cursor == I2C_QUEUE.front_buffer_end) {
     if (I2C_QUEUE.pending_buffer_switch) {
       /* Producer is done, we can switch buffers now. */
       i2c_queue_switch_buffers();
@@ -209,22 +295,31 @@ i2c_queue_process_command(void)
         i2c_queue_start_transmitter();
       }
 
-      if (I2C_QUEUE.tasks_n > 0) {
+      if (!i2c_tasks_is_empty(&(I2C_QUEUE.tasks))) {
         i2c_queue_fetch_commands();
       }
     }
     else {
-      I2C_QUEUE.current_command.code = I2C_COMMAND_PENDING;
+      I2C_QUEUE.current_command = I2C_COMMAND_PENDING;
     }
   }
   else {
-    I2C_QUEUE.current_command = I2C_QUEUE.front_buffer->commands[I2C_QUEUE.front_buffer_cursor];
-    assert(I2C_QUEUE.transmitter_active);
+    i2c_queue_load_record();
+
+    /* Transaction ended inside of the buffer, mux switch does that, and the
+     * next one has to be started manually too. STOP is already sent by now. */
+    if (!I2C_QUEUE.transmitter_active) {
+      i2c_queue_start_transmitter();
+    }
   }
 }
 
 
-ISR(TWI_vect) {
+static inline void
+i2c_handle_int(void)
+{
+  PROBE_BEGIN(TWI_ISR);
+
   uint8_t i2c_status = TWSR & TW_STATUS_MASK;
 
   if (i2c_status > TW_MT_DATA_ACK || i2c_status == TW_MT_SLA_NACK) {
@@ -232,31 +327,129 @@ ISR(TWI_vect) {
   }
 
   i2c_queue_process_command();
+
+  PROBE_END(TWI_ISR);
 }
 
+
+#if I2C_DRIVER == I2C_DRIVER_POLLED
+/* Does what the interrupt handler would, if TWI is done with the last byte.
+ * Producers run from here too, between bytes, with interrupts enabled.
+ */
+void
+i2c_poll(void)
+{
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    if (I2C_QUEUE.transmitter_active && (TWCR & _BV(TWINT))) {
+      i2c_handle_int();
+    }
+  }
+}
+#else
+#if I2C_ASYNC_FAST_ISR
+/* Full handler is entered from the fast path below, with all registers restored,
+ * so it behaves just as if it was called directly from the interrupt vector.
+ */
+void __vector_i2c_slow(void) __attribute__((signal, used, externally_visible));
+
+void __vector_i2c_slow(void)
+#else
+ISR(TWI_vect)
+#endif
+{
+  i2c_handle_int();
+}
+#endif
+
+
+#if I2C_ASYNC_FAST_ISR
+/* Fast path for sending next byte of a data run, when it is not the last one.
+ * Only registers actually needed are saved, and everything else (run
+ * boundaries, PENDING, STOP and error statuses) is left to the full handler.
+ */
+ISR(TWI_vect, ISR_NAKED)
+{
+  __asm__ __volatile__ (
+    "push r24" "\n\t"
+    "in r24, __SREG__" "\n\t"
+    "push r24" "\n\t"
+
+    /* Previous byte has to be acknowledged */
+    "lds r24, %[twsr]" "\n\t"
+    "andi r24, %[status_mask]" "\n\t"
+    "cpi r24, %[data_ack]" "\n\t"
+    "brne 1f" "\n\t"
+
+    /* At least one more byte has to be left in the run after this one */
+    "lds r24, %[run_remaining]" "\n\t"
+    "cpi r24, 2" "\n\t"
+    "brlo 1f" "\n\t"
+    "dec r24" "\n\t"
+    "sts %[run_remaining], r24" "\n\t"
+
+    "push r30" "\n\t"
+    "push r31" "\n\t"
+    "lds r30, %[cursor]" "\n\t"
+    "lds r31, %[cursor] + 1" "\n\t"
+    "ld r24, Z+" "\n\t"
+    "sts %[twdr], r24" "\n\t"
+    "ldi r24, %[twcr_send]" "\n\t"
+    "sts %[twcr], r24" "\n\t"
+    "sts %[cursor], r30" "\n\t"
+    "sts %[cursor] + 1, r31" "\n\t"
+    "pop r31" "\n\t"
+    "pop r30" "\n\t"
+
+    "pop r24" "\n\t"
+    "out __SREG__, r24" "\n\t"
+    "pop r24" "\n\t"
+    "reti" "\n\t"
+
+    "1:" "\n\t"
+    "pop r24" "\n\t"
+    "out __SREG__, r24" "\n\t"
+    "pop r24" "\n\t"
+    "%~jmp __vector_i2c_slow" "\n\t"
+    :
+    : [twsr] "n" (_SFR_MEM_ADDR(TWSR)),
+      [twdr] "n" (_SFR_MEM_ADDR(TWDR)),
+      [twcr] "n" (_SFR_MEM_ADDR(TWCR)),
+      [status_mask] "M" (TW_STATUS_MASK),
+      [data_ack] "M" (TW_MT_DATA_ACK),
+      [twcr_send] "M" (_BV(TWINT) | _BV(TWEN) | _BV(TWIE)),
+      [run_remaining] "i" (&(I2C_QUEUE.run_remaining)),
+      [cursor] "i" (&(I2C_QUEUE.front_buffer_cursor))
+  );
+}
+#endif
+
 /* User API ----------------------------------------------------------------- */
 
 void i2c_init(void)
 {
   I2C_QUEUE.front_buffer = &(I2C_QUEUE.buffer_a);
   I2C_QUEUE.front_buffer->length = 0;
-  I2C_QUEUE.front_buffer_cursor = 0;
+  I2C_QUEUE.front_buffer->open_run = I2C_NO_OPEN_RUN;
+  I2C_QUEUE.front_buffer_cursor = I2C_QUEUE.front_buffer->records;
+  I2C_QUEUE.front_buffer_end = I2C_QUEUE.front_buffer->records;
 
   I2C_QUEUE.back_buffer = &(I2C_QUEUE.buffer_b);
   I2C_QUEUE.back_buffer->length = 0;
+  I2C_QUEUE.back_buffer->open_run = I2C_NO_OPEN_RUN;
 
   I2C_QUEUE.pending_buffer_switch = false;
   I2C_QUEUE.transmitter_active = false;
-  I2C_QUEUE.tasks_n = 0;
-
-  I2C_QUEUE.current_command.code = I2C_COMMAND_PENDING;
-
-  ring_buffer_init(
-    &(I2C_QUEUE.tasks),
-    I2C_QUEUE.tasks_storage, /* storage */
-    sizeof(i2c_task_t), /* element_size */
-    sizeof(I2C_QUEUE.tasks_storage) / sizeof(i2c_task_t) /* elements_max */
-  );
+  i2c_tasks_init(&(I2C_QUEUE.tasks));
+
+  I2C_QUEUE.current_command = I2C_COMMAND_PENDING;
+  I2C_QUEUE.run_remaining = 0;
+#if I2C_MUX
+  /* All channels are deselected after reset */
+  I2C_QUEUE.mux_channel = I2C_MUX_NO_CHANNEL;
+#endif
+#if TRAFFIC_STATS
+  i2c_reset_stats();
+#endif
 
   i2c_hw_init();
 }
@@ -268,142 +461,265 @@ i2c_is_idle(void)
   bool result = false;
 
   ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
-    result = !(I2C_QUEUE.transmitter_active) && (I2C_QUEUE.tasks_n == 0);
+    result = !(I2C_QUEUE.transmitter_active) && i2c_tasks_is_empty(&(I2C_QUEUE.tasks));
   }
 
   return result;
 }
 
 
+/* Woken up by the TWI interrupt, or anything else, to check again */
 void
 i2c_wait(void)
 {
-  while (!i2c_is_idle());
+  cli();
+
+  while (I2C_QUEUE.transmitter_active || !i2c_tasks_is_empty(&(I2C_QUEUE.tasks))) {
+    idle_wait();
+    cli();
+  }
+
+  sei();
+}
+
+
+#if TRAFFIC_STATS
+i2c_stats_t
+i2c_get_stats(void)
+{
+  i2c_stats_t stats;
+
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    stats = I2C_QUEUE.stats;
+  }
+
+  return stats;
+}
+
+
+void
+i2c_reset_stats(void)
+{
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    I2C_QUEUE.stats = (i2c_stats_t) {0};
+  }
 }
+#endif
 
 
 void
-i2c_transmit_async(uint8_t address, i2c_callback_t callback, void *data)
+i2c_transmit_async(uint8_t channel, uint8_t address, i2c_callback_t callback, void *data)
 {
   ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
-    ring_buffer_assert_can_write_n_elements(&(I2C_QUEUE.tasks), 1);
+    /* Nobody will pick the task up, unless a producer is already running or
+     * a filled buffer waits for the switch, so start producing right away.
+     * Transmitter may well be still busy with the front buffer. */
+    bool fetch = i2c_tasks_is_empty(&(I2C_QUEUE.tasks)) && !(I2C_QUEUE.pending_buffer_switch);
 
-    i2c_task_t *task = (i2c_task_t *) ring_buffer_append(&(I2C_QUEUE.tasks));
-    bool is_idle = i2c_is_idle();
+    i2c_task_t *task = i2c_tasks_reserve(&(I2C_QUEUE.tasks));
 
     task->address = address;
+#if I2C_MUX
+    task->channel = channel;
+#endif
     task->callback = callback;
     task->data = data;
 
-    ++I2C_QUEUE.tasks_n;
+    i2c_tasks_commit(&(I2C_QUEUE.tasks));
 
-    if (is_idle) {
+    if (fetch) {
       i2c_queue_fetch_commands();
     }
   }
 }
 
 static inline void
-i2c_produce_command(i2c_command_code_t code, uint8_t data)
+i2c_produce_record(uint8_t header)
 {
-  assert(I2C_BUFFER_SIZE - I2C_QUEUE.back_buffer->length >= 1);
+  i2c_command_buffer_t *buffer = I2C_QUEUE.back_buffer;
 
-  i2c_command_t *command = &(I2C_QUEUE.back_buffer->commands[I2C_QUEUE.back_buffer->length]);
+  assert(I2C_BUFFER_SIZE - buffer->length >= 1);
+
+  buffer->records[buffer->length] = header;
+  ++(buffer->length);
+  buffer->open_run = I2C_NO_OPEN_RUN;
+}
 
-  command->code = code;
-  command->data = data;
 
-  ++(I2C_QUEUE.back_buffer->length);
+/* Makes sure that data run is open at the end of back buffer and returns how
+ * many of `n` bytes can be appended to it.
+ */
+static inline uint8_t
+i2c_open_data_run(uint8_t n)
+{
+  i2c_command_buffer_t *buffer = I2C_QUEUE.back_buffer;
+
+  if (buffer->open_run == I2C_NO_OPEN_RUN ||
+    buffer->records[buffer->open_run] == (I2C_RECORD_DATA_RUN | I2C_RECORD_MAX_RUN_LENGTH))
+  {
+    assert(I2C_BUFFER_SIZE - buffer->length >= 1);
+
+    buffer->open_run = buffer->length;
+    buffer->records[buffer->length] = I2C_RECORD_DATA_RUN;
+    ++(buffer->length);
+  }
+
+  uint8_t run_length = buffer->records[buffer->open_run] & I2C_RECORD_RUN_LENGTH_MASK;
+
+  return int_min(n, I2C_RECORD_MAX_RUN_LENGTH - run_length);
 }
 
 
 void
 i2c_async_send_byte(uint8_t data)
 {
-  i2c_produce_command(I2C_COMMAND_SEND_DATA, data);
+  i2c_command_buffer_t *buffer = I2C_QUEUE.back_buffer;
+
+  i2c_open_data_run(1);
+  assert(I2C_BUFFER_SIZE - buffer->length >= 1);
+
+  buffer->records[buffer->length] = data;
+  ++(buffer->length);
+  ++(buffer->records[buffer->open_run]);
 }
 
 
 void
 i2c_async_send_bytes(uint8_t *data, uint8_t n)
 {
+  i2c_command_buffer_t *buffer = I2C_QUEUE.back_buffer;
+
   assert(n > 0);
-  assert(I2C_BUFFER_SIZE - I2C_QUEUE.back_buffer->length >= n);
 
-  i2c_command_t *commands = &(I2C_QUEUE.back_buffer->commands[I2C_QUEUE.back_buffer->length]);
+  while (n > 0) {
+    uint8_t run_n = i2c_open_data_run(n);
+    assert(I2C_BUFFER_SIZE - buffer->length >= run_n);
+
+    memcpy(&(buffer->records[buffer->length]), data, run_n);
+    buffer->length += run_n;
+    buffer->records[buffer->open_run] += run_n;
 
-  for (uint8_t i = 0; i < n; ++i) {
-    commands[i].code = I2C_COMMAND_SEND_DATA;
-    commands[i].data = data[i];
+    data += run_n;
+    n -= run_n;
   }
 
-  I2C_QUEUE.back_buffer->length += n;
-  assert(I2C_QUEUE.back_buffer->length > 0);
+  assert(buffer->length > 0);
 }
 
 
-void
-i2c_async_send_start(void)
+/* Returns space for `n` data bytes at the end of the back buffer, so that
+ * producer can write them in place instead of having them copied. Nothing else
+ * can be sent before i2c_async_commit_bytes(), which appends them to the run.
+ */
+uint8_t *
+i2c_async_reserve_bytes(uint8_t n)
 {
-  ring_buffer_assert_can_read_n_elements(&(I2C_QUEUE.tasks), 1);
+  i2c_command_buffer_t *buffer = I2C_QUEUE.back_buffer;
+
+  assert(n > 0 && n <= I2C_RESERVE_MAX);
+
+  if (i2c_open_data_run(n) < n) {
+    /* Bytes have to be contiguous, so they start a new run */
+    buffer->open_run = I2C_NO_OPEN_RUN;
+    i2c_open_data_run(n);
+  }
 
-  i2c_task_t *task = (i2c_task_t *) ring_buffer_get_first(&(I2C_QUEUE.tasks));
+  assert(I2C_BUFFER_SIZE - buffer->length >= n);
 
-  i2c_produce_command(I2C_COMMAND_START, 0);
-  assert((task->address & 1) == 0);
-  i2c_produce_command(I2C_COMMAND_SEND_DATA, task->address);
+  return &(buffer->records[buffer->length]);
 }
 
 
+/* Up to the number of bytes reserved can be committed */
 void
-i2c_async_end_transmission(void)
+i2c_async_commit_bytes(uint8_t n)
 {
-  i2c_produce_command(I2C_COMMAND_STOP, 0);
+  i2c_command_buffer_t *buffer = I2C_QUEUE.back_buffer;
+
+  assert(n > 0);
+  assert(buffer->open_run != I2C_NO_OPEN_RUN);
+  assert(I2C_BUFFER_SIZE - buffer->length >= n);
+
+  buffer->length += n;
+  buffer->records[buffer->open_run] += n;
 }
 
 
-typedef struct transmit_progmem_t_ {
-  uint16_t length;
-  uint16_t counter;
-  const uint8_t *data;
-} transmit_progmem_t;
+#if I2C_MUX
+static inline bool
+i2c_mux_switch_pending(void)
+{
+  return i2c_tasks_get_first(&(I2C_QUEUE.tasks))->channel != I2C_QUEUE.mux_channel;
+}
+#endif
 
 
-bool
-i2c_transmit_progmem_cb(void *cb_data)
+/* Bytes producer can still put into the back buffer in this callback call */
+uint8_t
+i2c_async_capacity(void)
 {
-  transmit_progmem_t *ctrl = (transmit_progmem_t *) cb_data;
+  uint8_t capacity = I2C_BUFFER_SIZE - I2C_QUEUE.back_buffer->length;
 
-  if (ctrl->counter == 0) {
-    i2c_async_send_start();
+#if I2C_MUX
+  if (i2c_mux_switch_pending()) {
+    capacity = (capacity > I2C_MUX_SWITCH_SIZE) ? capacity - I2C_MUX_SWITCH_SIZE : 0;
   }
+#endif
 
-  if (ctrl->counter < ctrl->length) {
-    for (uint8_t i = 0; i < 16 && ctrl->counter < ctrl->length; ++i) {
-      i2c_async_send_byte(pgm_read_byte(ctrl->data + ctrl->counter));
-      ++ctrl->counter;
-    }
+  return capacity;
+}
 
-    return true;
-  }
 
-  ctrl->counter = 0;
-  i2c_async_end_transmission();
-  return false;
+void
+i2c_async_send_start(void)
+{
+  i2c_async_send_start_to(i2c_tasks_get_first(&(I2C_QUEUE.tasks))->address);
+}
+
 
+static void
+i2c_produce_start(uint8_t address)
+{
+  i2c_command_buffer_t *buffer = I2C_QUEUE.back_buffer;
+
+  i2c_produce_record(I2C_COMMAND_START);
+  assert((address & 1) == 0);
+  assert(I2C_BUFFER_SIZE - buffer->length >= 1);
+
+  buffer->records[buffer->length] = address;
+  ++(buffer->length);
 }
 
+
+/* Channel of the task is selected before its first START only, tasks on the
+ * same channel follow each other without switching. */
 void
-i2c_transmit_progmem(uint8_t address, const uint8_t *data, uint16_t length)
+i2c_async_send_start_to(uint8_t address)
 {
-  transmit_progmem_t ctrl;
+#if I2C_MUX
+  if (i2c_mux_switch_pending()) {
+    uint8_t channel = i2c_tasks_get_first(&(I2C_QUEUE.tasks))->channel;
+
+    assert(channel < 8);
 
-  ctrl.length = length;
-  ctrl.counter = 0;
-  ctrl.data = data;
+    i2c_produce_start(I2C_MUX_ADDRESS);
+    i2c_async_send_byte(1 << channel);
+    i2c_produce_record(I2C_COMMAND_STOP);
+
+    I2C_QUEUE.mux_channel = channel;
+    i2c_count(mux_switches);
+  }
+#endif
 
-  i2c_transmit_async(address, i2c_transmit_progmem_cb, &ctrl);
-  i2c_wait();
+  i2c_produce_start(address);
 }
 
+
+void
+i2c_async_end_transmission(void)
+{
+  i2c_produce_record(I2C_COMMAND_STOP);
+}
+
+
 /* end of User API ---------------------------------------------------------- */
@@ -2,17 +2,20 @@
 #include <stdlib.h>
 #include <avr/io.h>
 #include <avr/interrupt.h>
-#include <avr/pgmspace.h>
 #include <util/atomic.h>
 #include <util/twi.h>
 #include "config.h"
 #include "fault.h"
 #include "assert.h"
-#include "ring_buffer.h"
 #include "i2c_hw.h"
 
 
 static uint8_t I2C_CURRENT_ADDRESS;
+#if I2C_MUX
+static uint8_t I2C_CURRENT_CHANNEL;
+static uint8_t I2C_MUX_CHANNEL = 0xff;
+#endif
+static uint8_t I2C_RESERVED[I2C_RESERVE_MAX];
 
 
 void i2c_init(void)
@@ -35,10 +38,30 @@ i2c_wait(void)
 }
 
 
+#if TRAFFIC_STATS
+i2c_stats_t
+i2c_get_stats(void)
+{
+  /* There's no queue */
+  return (i2c_stats_t) {0};
+}
+
+
+void
+i2c_reset_stats(void)
+{
+  /* Nothing to do here */
+}
+#endif
+
+
 void
-i2c_transmit_async(uint8_t address, i2c_callback_t callback, void *data)
+i2c_transmit_async(uint8_t channel, uint8_t address, i2c_callback_t callback, void *data)
 {
   I2C_CURRENT_ADDRESS = address;
+#if I2C_MUX
+  I2C_CURRENT_CHANNEL = channel;
+#endif
   while (callback(data));
 }
 
@@ -74,33 +97,67 @@ i2c_async_send_bytes(uint8_t *data, uint8_t n)
 }
 
 
+/* Reserved bytes are sent once committed */
+uint8_t *
+i2c_async_reserve_bytes(uint8_t n)
+{
+  assert(n > 0 && n <= I2C_RESERVE_MAX);
+
+  return I2C_RESERVED;
+}
+
+
 void
-i2c_async_send_start(void)
+i2c_async_commit_bytes(uint8_t n)
+{
+  i2c_async_send_bytes(I2C_RESERVED, n);
+}
+
+
+/* Bytes are sent right away, so there's no limit */
+uint8_t
+i2c_async_capacity(void)
+{
+  return 0xff;
+}
+
+
+static void
+i2c_send_start_to(uint8_t address)
 {
   i2c_hw_send_start_condition();
   i2c_hw_wait_for_int();
   i2c_check_status();
-  i2c_async_send_byte(I2C_CURRENT_ADDRESS);
+  i2c_async_send_byte(address);
 }
 
 
 void
-i2c_async_end_transmission(void)
+i2c_async_send_start(void)
 {
-  i2c_hw_send_stop_condition();
+  i2c_async_send_start_to(I2C_CURRENT_ADDRESS);
 }
 
 
+/* Mux takes the channel mask with STOP, see i2c_async.c */
 void
-i2c_transmit_progmem(uint8_t address, const uint8_t *data, uint16_t length)
+i2c_async_send_start_to(uint8_t address)
 {
-  I2C_CURRENT_ADDRESS = address;
-  i2c_async_send_start();
-
-  for (uint16_t i = 0; i < length; ++i) {
-    uint8_t byte = pgm_read_byte(data + i);
-    i2c_async_send_byte(byte);
+#if I2C_MUX
+  if (I2C_CURRENT_CHANNEL != I2C_MUX_CHANNEL) {
+    i2c_send_start_to(I2C_MUX_ADDRESS);
+    i2c_async_send_byte(1 << I2C_CURRENT_CHANNEL);
+    i2c_hw_send_stop_condition();
+    I2C_MUX_CHANNEL = I2C_CURRENT_CHANNEL;
   }
+#endif
+
+  i2c_send_start_to(address);
+}
+
 
-  i2c_async_end_transmission();
+void
+i2c_async_end_transmission(void)
+{
+  i2c_hw_send_stop_condition();
 }
@@ -0,0 +1,40 @@
+#ifndef IDLE_H
+#define IDLE_H
+
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+#include "config.h"
+#include "i2c.h"
+
+
+/* Waiting loops check their condition with interrupts disabled and sleep
+ * until an interrupt, that could have changed it, wakes the CPU up:
+ *
+ *   cli();
+ *   while (!done) {
+ *     idle_wait();
+ *     cli();
+ *   }
+ *   sei();
+ *
+ * Instruction following sei is always executed, before any interrupt, so it
+ * can't slip in between the check and sleep. Sleep mode is idle, the default
+ * one, and every interrupt wakes the CPU up. Polled I2C driver needs the CPU
+ * to move the bus forward, so it's polled instead.
+ */
+static inline void
+idle_wait(void)
+{
+#if I2C_DRIVER == I2C_DRIVER_POLLED
+  sei();
+  i2c_poll();
+#else
+  sleep_enable();
+  sei();
+  sleep_cpu();
+  sleep_disable();
+#endif
+}
+
+
+#endif /* IDLE_H */
@@ -161,6 +161,77 @@ class CBitmap(object):
       f.write("};\n")
 
 
+RLE_REPEAT = 0x80
+RLE_MAX_LENGTH = 0x80
+RLE_MIN_REPEAT = 3
+
+
+class CRleBitmap(CBitmap):
+  """Each page is compressed separately, into records of either a repeated
+  byte (header with RLE_REPEAT bit set) or a literal run of bytes. Lower bits
+  of the header hold length - 1. Pages are preceded by an index of 16-bit
+  offsets, relative to the first page, so any page can be found quickly."""
+
+  def compress_page(self, page):
+    data = page
+    result = []
+    literal = []
+
+    def flush_literal():
+      while literal:
+        chunk = literal[:RLE_MAX_LENGTH]
+        del literal[:RLE_MAX_LENGTH]
+        result.append(len(chunk) - 1)
+        result.extend(chunk)
+
+    i = 0
+
+    while i < len(data):
+      repeat = 1
+
+      while i + repeat < len(data) and repeat < RLE_MAX_LENGTH and data[i + repeat] == data[i]:
+        repeat += 1
+
+      if repeat >= RLE_MIN_REPEAT:
+        flush_literal()
+        result.append(RLE_REPEAT | (repeat - 1))
+        result.append(data[i])
+        i += repeat
+      else:
+        literal.append(data[i])
+        i += 1
+
+    flush_literal()
+    return result
+
+
+  def write(self, path):
+    pages_n = len(self.data) // self.width
+    pages = [self.compress_page(self.data[page * self.width:(page + 1) * self.width]) for page in range(pages_n)]
+
+    index = []
+    offset = 0
+
+    for page in pages:
+      index.extend([offset & 0xff, offset >> 8])
+      offset += len(page)
+
+    with open(path, 'w') as f:
+      f.write("#include <stdint.h>\n")
+      f.write("#include <avr/pgmspace.h>\n\n")
+      f.write("const uint8_t %s[%d] PROGMEM = {\n" % (self.name, 2 + len(index) + offset))
+      f.write("  0x%02x, /* = width */\n  0x%02x, /* = height */\n" % (self.width, self.height))
+      f.write("  /* page offsets */\n  %s\n" % ' '.join('0x%02x,' % i for i in index))
+
+      for n, page in enumerate(pages):
+        f.write("  /* page %d */\n" % n)
+
+        for i in range(0, len(page), 16):
+          f.write("  %s\n" % ' '.join('0x%02x,' % b for b in page[i:i + 16]))
+
+      f.write("};\n")
+
+
 def dither(source, target, algo='floyd-steinberg', inverted=False):
   algo = DITHERING_ALGORITHMS[algo]
 
@@ -210,7 +281,18 @@ else:
   dithering = 'jarvis-judice-ninke'
 
 
+if len(sys.argv) >= 7:
+  output_format = sys.argv[6]
+else:
+  output_format = 'raw'
+
+OUTPUT_FORMATS = {
+  'raw': CBitmap,
+  'rle': CRleBitmap,
+}
+
+
 input_bitmap = Bmp(input_path)
-output_bitmap = CBitmap(name, input_bitmap.width, input_bitmap.height)
+output_bitmap = OUTPUT_FORMATS[output_format](name, input_bitmap.width, input_bitmap.height)
 dither(input_bitmap, output_bitmap, dithering, inverted=True)
 output_bitmap.write(output_path)
@@ -5,6 +5,7 @@
 
 
 extern const uint8_t BACKGROUND[1026];
+extern const uint8_t BACKGROUND_RLE[323];
 extern const uint8_t PEAK_INDICATOR[23];
 
 #endif
@@ -4,104 +4,218 @@
 #include <avr/interrupt.h>
 #include <avr/pgmspace.h>
 #include <util/delay.h>
+#include <util/atomic.h>
 #include "config.h"
 #include "assert.h"
+#include "utils.h"
 #include "i2c.h"
+#include "spi.h"
 #include "lcd.h"
 #include "images.h"
 #include "ssd1306.h"
 #include "display.h"
 #include "progmem_image_sprite.h"
+#include "progmem_rle_image_sprite.h"
 #include "needle_sprite.h"
+#include "vu_meter.h"
 #include "benchmark.h"
 #include "adc.h"
+#include "ballistics.h"
+#include "probe.h"
+#include "idle.h"
+#include "telemetry.h"
 
 
-typedef struct vu_meter_t_ {
-  ssd1306_t device;
-  display_t display;
-  needle_sprite_t needle;
-  region_t update_regions[18];
-  update_extents_t update_extents;
-} vu_meter_t;
+#if BACKGROUND_COMPRESSED
+progmem_rle_image_sprite_t BACKGROUND_SPRITE;
+#else
+progmem_image_sprite_t BACKGROUND_SPRITE;
+#endif
 
+/* Sorted by mux channel, see vu_meter_init_all() */
+vu_meter_t METERS[VU_METERS_N];
+uint8_t METER_CONFIG_INDICES[VU_METERS_N];
+
+#define METER_SOURCE(address, channel, source) source,
+
+static const uint8_t METER_SOURCES[VU_METERS_N] = { VU_METERS(METER_SOURCE) };
 
-progmem_image_sprite_t BACKGROUND_SPRITE;
-progmem_image_sprite_t PEAK_INDICATOR_SPRITE;
-vu_meter_t VU_METER_L;
-vu_meter_t VU_METER_R;
 
+#if FRAME_RATE
+#define FRAME_PERIOD ((time_t) 1000000 / FRAME_RATE)
 
-void
-vu_meter_init(vu_meter_t *meter, int8_t address)
+/* Frames are started at fixed rate, unless we're late. Then the next one
+ * starts right away, but missed frames are not made up for. CPU sleeps in
+ * between, woken up by ADC samples at least, so frames start within 1 /
+ * (2 * ADC_SAMPLE_RATE) of their due time. */
+static void
+wait_for_frame(time_t *frame_due)
 {
-  meter->update_extents.regions = meter->update_regions;
+  time_t now;
 
-  ssd1306_init(&(meter->device), address);
-  display_init(&(meter->display), &(meter->device));
+  cli();
 
-  display_add_sprite(&(meter->display), &(BACKGROUND_SPRITE.sprite));
-  display_add_sprite(&(meter->display), &(PEAK_INDICATOR_SPRITE.sprite));
+  while (time_diff(now = get_current_time(), *frame_due) < 0) {
+    idle_wait();
+    cli();
+  }
+
+  sei();
 
-  needle_sprite_init(&(meter->needle));
-  needle_sprite_draw(&(meter->needle), 0);
-  display_add_sprite(&(meter->display), &(meter->needle).sprite);
+  *frame_due += FRAME_PERIOD;
 
-  display_update_async(&(meter->display));
+  if (time_diff(now, *frame_due) >= 0) {
+    *frame_due = now + FRAME_PERIOD;
+  }
 }
+#endif
 
 
-void
-vu_meter_update(vu_meter_t *meter, uint8_t angle)
+/* 100% is 0VU, at 0.708 of the full scale, see images/scale. Multiplied by
+ * 116 / 64 = 1.81, so there's no division. */
+static uint8_t
+percent_to_angle(uint16_t percent)
 {
-  update_extents_reset(&(meter->update_extents));
-  needle_sprite_add_to_extents(&(meter->needle), &(meter->update_extents));
-
-  needle_sprite_draw(&(meter->needle), angle);
-  needle_sprite_add_to_extents(&(meter->needle), &(meter->update_extents));
-  update_extents_optimize(&(meter->update_extents));
+  if (percent > 140) {
+    return 255;
+  }
 
-  display_update_partial_async(&(meter->display), &(meter->update_extents));
+  return (percent * 116) >> 6;
 }
 
 
-static uint8_t
-percent_to_angle(int percent)
+#if TELEMETRY
+static void
+send_telemetry(time_t frame_time)
 {
-  return percent * 181 / 100;
+  telemetry_frame_t frame;
+
+  frame.flags = adc_is_peak(ADC_CHANNEL_L) ? TELEMETRY_FLAG_PEAK : 0;
+  frame.frame_time = (frame_time > 0xffff) ? 0xffff : frame_time;
+  frame.adc[ADC_CHANNEL_L] = adc_get_latest(ADC_CHANNEL_L);
+  frame.adc[ADC_CHANNEL_R] = adc_get_latest(ADC_CHANNEL_R);
+
+  /* Record has room for the first two meters */
+  for (uint8_t i = 0; i < 2; ++i) {
+    frame.needle[i] = (i < VU_METERS_N) ? needle_sprite_get_index(&(METERS[i].needle)) : 0;
+  }
+
+  frame.bus_bytes = 0;
+
+#if TRAFFIC_STATS
+  frame.flags |= TELEMETRY_FLAG_TRAFFIC_STATS;
+
+  /* Producers count bytes from the TWI interrupt handler */
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    for (uint8_t i = 0; i < VU_METERS_N; ++i) {
+      ssd1306_stats_t *stats = &(METERS[i].device.stats);
+      frame.bus_bytes += stats->address_bytes + stats->control_bytes + stats->cursor_bytes +
+        stats->payload_bytes;
+      ssd1306_reset_stats(&(METERS[i].device));
+    }
+  }
+#endif
+
+#if PROBES_ENABLED
+  for (uint8_t id = 0; id < PROBES_N; ++id) {
+    probe_t probe;
+
+    probe_take(id, &probe);
+    frame.probes[id] = (telemetry_probe_t) { probe.count, probe.sum, probe.max };
+  }
+#endif
+
+  telemetry_send_frame(&frame);
 }
+#endif
 
 
 int main(void)
 {
+#if LCD_ENABLED
   lcd_init();
+#endif
   i2c_init();
+#if TELEMETRY
+  telemetry_init();
+#endif
+#if DISPLAY_TRANSPORT == DISPLAY_TRANSPORT_SPI
+  spi_init();
+#endif
+  adc_start_sampling();
   sei();
 
+#if BALLISTICS && BALLISTICS_BENCHMARK
+  {
+    /* Time in us equals cycles per step divided by F_CPU in MHz, times 1000 */
+    ballistics_t ballistics;
+    ballistics_init(&ballistics, ADC_ZERO);
+    BENCHMARK(ballistics_x1000, for (uint16_t i = 0; i < 1000; ++i) ballistics_step(&ballistics, i));
+    _delay_ms(3000);
+  }
+#endif
+
+#if BACKGROUND_COMPRESSED
+  progmem_rle_image_sprite_init(&BACKGROUND_SPRITE, BACKGROUND_RLE, 0, 0);
+#else
   progmem_image_sprite_init(&BACKGROUND_SPRITE, BACKGROUND, 0, 0);
-  progmem_image_sprite_init(&PEAK_INDICATOR_SPRITE, PEAK_INDICATOR, 107, 7);
+#endif
 
-  vu_meter_init(&VU_METER_L, DISPLAY_A_ADDRESS);
-  vu_meter_init(&VU_METER_R, DISPLAY_B_ADDRESS);
+  vu_meter_init_all(METERS, METER_CONFIG_INDICES, &(BACKGROUND_SPRITE.sprite));
+  vu_meter_redraw_all(METERS, VU_METERS_N);
   i2c_wait();
 
-  benchmark_start();
+  time_t frame_start = benchmark_start();
+  int16_t fps = 0;
+  bool backwards = false;
+#if PROBES_ENABLED && !TELEMETRY
+  time_t probes_dumped = frame_start;
+#endif
+#if FRAME_RATE
+  time_t frame_due = frame_start;
+#endif
 
   while (1) {
-    uint16_t adc_l = adc_get(2);
-    int16_t angle_l = (int32_t) (498 - adc_l) * 128 / 164;
-    if (angle_l < 0) angle_l = -angle_l;
-    if (angle_l > 255) angle_l = 255;
-
-    i2c_wait();
-    time_t frame_start = get_current_time();
-    vu_meter_update(&VU_METER_L, angle_l);
-    i2c_wait();
-    time_t frame_time = get_current_time() - frame_start;
-    int16_t fps = (int32_t) 1000000 / frame_time;
-
-    PEAK_INDICATOR_SPRITE.sprite.visible = (angle_l > 192);
-
-    vu_meter_update(&VU_METER_R, percent_to_angle(fps / 2));
+#if FRAME_RATE
+    wait_for_frame(&frame_due);
+#endif
+
+    /* All meters are queued together, so each one is rendered while the
+     * previous one is still being sent. Each update waits only for previous
+     * update of its own meter, and is skipped if nothing changed. With the mux,
+     * every other frame goes backwards, starting on the channel the previous
+     * one ended on, so there's one channel switch less.
+     */
+    for (uint8_t n = 0; n < VU_METERS_N; ++n) {
+      uint8_t i = backwards ? VU_METERS_N - 1 - n : n;
+      uint8_t source = METER_SOURCES[METER_CONFIG_INDICES[i]];
+      uint8_t angle = (source == VU_METER_SHOWS_FPS) ?
+        percent_to_angle(fps / 2) : adc_get_needle_angle(source);
+
+      /* Peak of the channel the meter shows, FPS never peaks */
+      vu_meter_show_peak(&(METERS[i]), source != VU_METER_SHOWS_FPS && adc_is_peak(source));
+      vu_meter_update(&(METERS[i]), angle);
+    }
+
+    backwards = I2C_MUX && !backwards;
+
+    time_t frame_end = get_current_time();
+    time_t frame_time = frame_end - frame_start;
+    frame_start = frame_end;
+
+    /* Frames with every update skipped can take next to no time, FPS is
+     * clamped so it still fits */
+    fps = (int32_t) 1000000 / int_max(frame_time, (time_t) (1000000 / INT16_MAX + 1));
+
+#if TELEMETRY
+    /* Probes are sent with each frame, instead of being shown on the LCD */
+    send_telemetry(frame_time);
+#elif PROBES_ENABLED
+    /* One probe each second */
+    if (frame_end - probes_dumped >= 1000000) {
+      probes_dumped = frame_end;
+      probe_dump_next();
+    }
+#endif
   }
 }
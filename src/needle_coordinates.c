@@ -132,3 +132,1286 @@ const needle_coordinates_t NEEDLE_COORDINATES[NEEDLE_RESOLUTION] PROGMEM = {
   { 126,  23 },
   { 127,  23 },
 };
+
+const needle_raster_t NEEDLE_RASTERS[NEEDLE_RESOLUTION] PROGMEM = {
+  { 23,  1, {
+    { -128, -128, -128, 0x00 },
+    { -128, -128, -128, 0x00 },
+    {    0,    3,    0, 0x00 },
+    {    0,   10,    1, 0x77 },
+    {    5,   17,    8, 0x6f },
+    {   12,   24,   15, 0x5f },
+    {   19,   31,   22, 0x3f },
+    {   26,   39,   29, 0x7f },
+  } },
+  { 23,  1, {
+    { -128, -128, -128, 0x00 },
+    { -128, -128, -128, 0x00 },
+    {    0,    4,    1, 0x00 },
+    {    0,   11,    2, 0x77 },
+    {    6,   18,    9, 0x77 },
+    {   13,   25,   16, 0x77 },
+    {   20,   32,   23, 0x77 },
+    {   27,   39,   30, 0x77 },
+  } },
+  { 22,  1, {
+    { -128, -128, -128, 0x00 },
+    { -128, -128, -128, 0x00 },
+    {    0,    6,    2, 0x40 },
+    {    1,   13,    4, 0x7d },
+    {    7,   19,   10, 0x5f },
+    {   14,   26,   17, 0x77 },
+    {   21,   33,   24, 0x7d },
+    {   27,   39,   30, 0x3f },
+  } },
+  { 21,  1, {
+    { -128, -128, -128, 0x00 },
+    { -128, -128, -128, 0x00 },
+    {    0,    8,    3, 0x60 },
+    {    2,   14,    5, 0x5f },
+    {    9,   21,   12, 0x77 },
+    {   16,   27,   19, 0x3e },
+    {   22,   34,   25, 0x6f },
+    {   29,   41,   32, 0x7b },
+  } },
+  { 21,  1, {
+    { -128, -128, -128, 0x00 },
+    { -128, -128, -128, 0x00 },
+    {    0,    8,    3, 0x60 },
+    {    2,   14,    5, 0x5f },
+    {    9,   21,   12, 0x77 },
+    {   16,   27,   19, 0x3e },
+    {   22,   34,   25, 0x6f },
+    {   29,   41,   32, 0x7b },
+  } },
+  { 20,  1, {
+    { -128, -128, -128, 0x00 },
+    { -128, -128, -128, 0x00 },
+    {    1,    9,    4, 0x30 },
+    {    4,   16,    7, 0x77 },
+    {   10,   22,   13, 0x6f },
+    {   17,   28,   20, 0x3d },
+    {   23,   35,   26, 0x7b },
+    {   29,   41,   32, 0x6f },
+  } },
+  { 19,  1, {
+    { -128, -128, -128, 0x00 },
+    { -128, -128, -128, 0x00 },
+    {    2,   11,    5, 0x58 },
+    {    6,   17,    9, 0x3d },
+    {   12,   24,   15, 0x7b },
+    {   18,   30,   21, 0x77 },
+    {   25,   36,   28, 0x6e },
+    {   31,   42,   34, 0x5d },
+  } },
+  { 19,  1, {
+    { -128, -128, -128, 0x00 },
+    { -128, -128, -128, 0x00 },
+    {    3,   12,    6, 0x58 },
+    {    7,   18,   10, 0x5d },
+    {   13,   24,   16, 0x3d },
+    {   19,   30,   22, 0x3b },
+    {   25,   36,   28, 0x3b },
+    {   31,   43,   34, 0x77 },
+  } },
+  { 18,  1, {
+    { -128, -128, -128, 0x00 },
+    { -128, -128, -128, 0x00 },
+    {    4,   14,    7, 0x74 },
+    {    8,   20,   11, 0x77 },
+    {   14,   25,   17, 0x3b },
+    {   20,   31,   23, 0x5b },
+    {   26,   37,   29, 0x5d },
+    {   32,   43,   35, 0x6d },
+  } },
+  { 17,  1, {
+    { -128, -128, -128, 0x00 },
+    { -128, -128, -128, 0x00 },
+    {    5,   15,    8, 0x3a },
+    {   10,   21,   13, 0x5d },
+    {   16,   27,   19, 0x6e },
+    {   22,   33,   25, 0x76 },
+    {   27,   38,   30, 0x3b },
+    {   33,   44,   36, 0x5d },
+  } },
+  { 17,  1, {
+    { -128, -128, -128, 0x00 },
+    { -128, -128, -128, 0x00 },
+    {    6,   16,    9, 0x3a },
+    {   11,   22,   14, 0x6d },
+    {   17,   28,   20, 0x76 },
+    {   22,   33,   25, 0x5b },
+    {   28,   39,   31, 0x6d },
+    {   34,   44,   37, 0x36 },
+  } },
+  { 16,  1, {
+    { -128, -128, -128, 0x00 },
+    { -128, -128, -128, 0x00 },
+    {    7,   18,   10, 0x6d },
+    {   12,   23,   15, 0x5b },
+    {   18,   29,   21, 0x6e },
+    {   23,   34,   26, 0x5b },
+    {   29,   39,   32, 0x36 },
+    {   34,   45,   37, 0x6d },
+  } },
+  { 16,  1, {
+    { -128, -128, -128, 0x00 },
+    { -128, -128, -128, 0x00 },
+    {    7,   18,   10, 0x6d },
+    {   12,   23,   15, 0x5b },
+    {   18,   29,   21, 0x6e },
+    {   23,   34,   26, 0x5b },
+    {   29,   39,   32, 0x36 },
+    {   34,   45,   37, 0x6d },
+  } },
+  { 15,  1, {
+    { -128, -128, -128, 0x00 },
+    {    8,   14,   11, 0x00 },
+    {    9,   19,   12, 0x36 },
+    {   14,   25,   17, 0x6d },
+    {   19,   30,   22, 0x5b },
+    {   25,   35,   28, 0x36 },
+    {   30,   41,   33, 0x6d },
+    {   35,   46,   38, 0x6d },
+  } },
+  { 14,  1, {
+    { -128, -128, -128, 0x00 },
+    {    9,   16,   12, 0x40 },
+    {   10,   21,   13, 0x6b },
+    {   15,   26,   18, 0x5b },
+    {   20,   31,   23, 0x5b },
+    {   25,   36,   28, 0x5b },
+    {   31,   41,   34, 0x5a },
+    {   36,   46,   39, 0x56 },
+  } },
+  { 14,  1, {
+    { -128, -128, -128, 0x00 },
+    {   10,   17,   13, 0x40 },
+    {   11,   22,   14, 0x6d },
+    {   16,   27,   19, 0x6d },
+    {   21,   32,   24, 0x6d },
+    {   26,   37,   29, 0x6d },
+    {   31,   42,   34, 0x6d },
+    {   36,   46,   39, 0x2d },
+  } },
+  { 13,  1, {
+    { -128, -128, -128, 0x00 },
+    {   11,   18,   14, 0x20 },
+    {   13,   23,   16, 0x56 },
+    {   18,   28,   21, 0x56 },
+    {   23,   33,   26, 0x5a },
+    {   27,   38,   30, 0x5b },
+    {   32,   43,   35, 0x6b },
+    {   37,   47,   40, 0x2d },
+  } },
+  { 13,  1, {
+    { -128, -128, -128, 0x00 },
+    {   12,   19,   15, 0x20 },
+    {   14,   24,   17, 0x56 },
+    {   19,   29,   22, 0x5a },
+    {   23,   34,   26, 0x6b },
+    {   28,   38,   31, 0x2d },
+    {   33,   43,   36, 0x35 },
+    {   38,   48,   41, 0x5a },
+  } },
+  { 12,  1, {
+    { -128, -128, -128, 0x00 },
+    {   13,   21,   16, 0x50 },
+    {   15,   25,   18, 0x2d },
+    {   20,   30,   23, 0x56 },
+    {   24,   34,   27, 0x2b },
+    {   29,   39,   32, 0x55 },
+    {   34,   44,   37, 0x6a },
+    {   38,   48,   41, 0x35 },
+  } },
+  { 12,  1, {
+    { -128, -128, -128, 0x00 },
+    {   14,   22,   17, 0x50 },
+    {   16,   26,   19, 0x35 },
+    {   21,   31,   24, 0x5a },
+    {   25,   35,   28, 0x35 },
+    {   30,   40,   33, 0x6a },
+    {   34,   44,   37, 0x35 },
+    {   39,   49,   42, 0x6a },
+  } },
+  { 11,  1, {
+    { -128, -128, -128, 0x00 },
+    {   15,   23,   18, 0x28 },
+    {   18,   28,   21, 0x6a },
+    {   22,   32,   25, 0x55 },
+    {   27,   36,   30, 0x2a },
+    {   31,   41,   34, 0x56 },
+    {   35,   45,   38, 0x35 },
+    {   40,   49,   43, 0x2a },
+  } },
+  { 11,  1, {
+    { -128, -128, -128, 0x00 },
+    {   16,   24,   19, 0x28 },
+    {   19,   28,   22, 0x2a },
+    {   23,   33,   26, 0x55 },
+    {   27,   37,   30, 0x55 },
+    {   32,   41,   35, 0x2a },
+    {   36,   46,   39, 0x5a },
+    {   40,   50,   43, 0x55 },
+  } },
+  { 10,  1, {
+    { -128, -128, -128, 0x00 },
+    {   17,   26,   20, 0x54 },
+    {   20,   30,   23, 0x55 },
+    {   24,   34,   27, 0x55 },
+    {   28,   38,   31, 0x55 },
+    {   32,   42,   35, 0x55 },
+    {   36,   46,   39, 0x35 },
+    {   41,   50,   44, 0x2a },
+  } },
+  { 10,  1, {
+    { -128, -128, -128, 0x00 },
+    {   18,   27,   21, 0x54 },
+    {   21,   31,   24, 0x55 },
+    {   25,   35,   28, 0x55 },
+    {   29,   39,   32, 0x55 },
+    {   33,   43,   36, 0x55 },
+    {   37,   47,   40, 0x55 },
+    {   41,   51,   44, 0x55 },
+  } },
+  {  9,  1, {
+    { -128, -128, -128, 0x00 },
+    {   19,   28,   22, 0x54 },
+    {   22,   32,   25, 0x55 },
+    {   26,   36,   29, 0x55 },
+    {   30,   40,   33, 0x55 },
+    {   34,   44,   37, 0x55 },
+    {   38,   47,   41, 0x25 },
+    {   42,   51,   45, 0x2a },
+  } },
+  {  9,  1, {
+    { -128, -128, -128, 0x00 },
+    {   20,   29,   23, 0x54 },
+    {   23,   33,   26, 0x55 },
+    {   27,   36,   30, 0x15 },
+    {   31,   40,   34, 0x2a },
+    {   35,   44,   38, 0x2a },
+    {   39,   48,   42, 0x4a },
+    {   42,   52,   45, 0x55 },
+  } },
+  {  8,  1, {
+    { -128, -128, -128, 0x00 },
+    {   21,   30,   24, 0x2a },
+    {   25,   34,   28, 0x52 },
+    {   28,   37,   31, 0x15 },
+    {   32,   41,   35, 0x2a },
+    {   36,   45,   39, 0x54 },
+    {   39,   48,   42, 0x25 },
+    {   43,   52,   46, 0x2a },
+  } },
+  {  8,  1, {
+    { -128, -128, -128, 0x00 },
+    {   22,   31,   25, 0x2a },
+    {   26,   35,   29, 0x54 },
+    {   29,   38,   32, 0x29 },
+    {   33,   42,   36, 0x52 },
+    {   36,   45,   39, 0x25 },
+    {   40,   49,   43, 0x4a },
+    {   43,   52,   46, 0x25 },
+  } },
+  {  7,  1, {
+    {   23,   29,   26, 0x00 },
+    {   23,   32,   26, 0x15 },
+    {   27,   36,   30, 0x4a },
+    {   30,   39,   33, 0x15 },
+    {   34,   43,   37, 0x4a },
+    {   37,   46,   40, 0x25 },
+    {   41,   50,   44, 0x52 },
+    {   44,   53,   47, 0x29 },
+  } },
+  {  7,  1, {
+    {   24,   30,   27, 0x00 },
+    {   24,   33,   27, 0x15 },
+    {   28,   37,   31, 0x52 },
+    {   31,   40,   34, 0x29 },
+    {   35,   43,   38, 0x14 },
+    {   38,   47,   41, 0x4a },
+    {   41,   50,   44, 0x25 },
+    {   45,   54,   48, 0x54 },
+  } },
+  {  6,  1, {
+    {   25,   31,   28, 0x00 },
+    {   26,   35,   29, 0x52 },
+    {   29,   38,   32, 0x4a },
+    {   32,   41,   35, 0x29 },
+    {   35,   44,   38, 0x25 },
+    {   39,   47,   42, 0x14 },
+    {   42,   51,   45, 0x52 },
+    {   45,   54,   48, 0x4a },
+  } },
+  {  6,  1, {
+    {   26,   32,   29, 0x00 },
+    {   27,   36,   30, 0x52 },
+    {   30,   39,   33, 0x52 },
+    {   33,   42,   36, 0x4a },
+    {   36,   45,   39, 0x49 },
+    {   39,   48,   42, 0x29 },
+    {   42,   51,   45, 0x25 },
+    {   45,   54,   48, 0x25 },
+  } },
+  {  6,  1, {
+    {   27,   33,   30, 0x00 },
+    {   28,   36,   31, 0x12 },
+    {   31,   39,   34, 0x12 },
+    {   34,   42,   37, 0x12 },
+    {   37,   45,   40, 0x12 },
+    {   40,   48,   43, 0x12 },
+    {   43,   52,   46, 0x52 },
+    {   46,   55,   49, 0x52 },
+  } },
+  {  5,  1, {
+    {   28,   35,   31, 0x40 },
+    {   29,   38,   32, 0x4a },
+    {   32,   41,   35, 0x4a },
+    {   35,   44,   38, 0x52 },
+    {   38,   46,   41, 0x12 },
+    {   41,   49,   44, 0x12 },
+    {   44,   52,   47, 0x12 },
+    {   47,   55,   50, 0x14 },
+  } },
+  {  5,  1, {
+    {   29,   36,   32, 0x40 },
+    {   30,   39,   33, 0x52 },
+    {   33,   41,   36, 0x12 },
+    {   36,   44,   39, 0x14 },
+    {   39,   47,   42, 0x24 },
+    {   41,   50,   44, 0x25 },
+    {   44,   53,   47, 0x49 },
+    {   47,   56,   50, 0x4a },
+  } },
+  {  5,  1, {
+    {   30,   37,   33, 0x40 },
+    {   31,   39,   34, 0x12 },
+    {   34,   42,   37, 0x14 },
+    {   37,   45,   40, 0x24 },
+    {   39,   48,   42, 0x49 },
+    {   42,   50,   45, 0x12 },
+    {   45,   53,   48, 0x12 },
+    {   48,   56,   51, 0x24 },
+  } },
+  {  4,  1, {
+    {   31,   38,   34, 0x20 },
+    {   32,   41,   35, 0x49 },
+    {   35,   43,   38, 0x12 },
+    {   38,   46,   41, 0x44 },
+    {   40,   48,   43, 0x12 },
+    {   43,   51,   46, 0x24 },
+    {   45,   54,   48, 0x49 },
+    {   48,   56,   51, 0x12 },
+  } },
+  {  4,  1, {
+    {   32,   39,   35, 0x20 },
+    {   33,   41,   36, 0x09 },
+    {   36,   44,   39, 0x24 },
+    {   38,   47,   41, 0x49 },
+    {   41,   49,   44, 0x24 },
+    {   43,   52,   46, 0x49 },
+    {   46,   54,   49, 0x22 },
+    {   48,   57,   51, 0x49 },
+  } },
+  {  4,  1, {
+    {   33,   40,   36, 0x20 },
+    {   34,   42,   37, 0x11 },
+    {   37,   45,   40, 0x44 },
+    {   39,   47,   42, 0x12 },
+    {   42,   50,   45, 0x48 },
+    {   44,   52,   47, 0x22 },
+    {   46,   55,   49, 0x49 },
+    {   49,   57,   52, 0x24 },
+  } },
+  {  3,  1, {
+    {   34,   41,   37, 0x10 },
+    {   35,   44,   38, 0x49 },
+    {   38,   46,   41, 0x24 },
+    {   40,   48,   43, 0x12 },
+    {   43,   51,   46, 0x48 },
+    {   45,   53,   48, 0x24 },
+    {   47,   55,   50, 0x11 },
+    {   50,   58,   53, 0x48 },
+  } },
+  {  3,  1, {
+    {   35,   42,   38, 0x10 },
+    {   36,   44,   39, 0x09 },
+    {   39,   47,   42, 0x44 },
+    {   41,   49,   44, 0x22 },
+    {   43,   51,   46, 0x12 },
+    {   45,   53,   48, 0x09 },
+    {   48,   56,   51, 0x44 },
+    {   50,   58,   53, 0x22 },
+  } },
+  {  3,  1, {
+    {   36,   43,   39, 0x10 },
+    {   37,   45,   40, 0x11 },
+    {   40,   47,   43, 0x08 },
+    {   42,   50,   45, 0x44 },
+    {   44,   52,   47, 0x24 },
+    {   46,   54,   49, 0x22 },
+    {   48,   56,   51, 0x11 },
+    {   50,   58,   53, 0x11 },
+  } },
+  {  2,  1, {
+    {   37,   44,   40, 0x08 },
+    {   39,   46,   42, 0x08 },
+    {   41,   48,   44, 0x08 },
+    {   43,   50,   46, 0x08 },
+    {   45,   52,   48, 0x08 },
+    {   47,   54,   50, 0x08 },
+    {   49,   57,   52, 0x44 },
+    {   51,   59,   54, 0x44 },
+  } },
+  {  2,  1, {
+    {   38,   45,   41, 0x10 },
+    {   39,   47,   42, 0x11 },
+    {   41,   49,   44, 0x11 },
+    {   43,   51,   46, 0x11 },
+    {   45,   53,   48, 0x11 },
+    {   47,   55,   50, 0x11 },
+    {   49,   57,   52, 0x21 },
+    {   51,   59,   54, 0x22 },
+  } },
+  {  2,  1, {
+    {   39,   46,   42, 0x10 },
+    {   40,   48,   43, 0x11 },
+    {   42,   50,   45, 0x21 },
+    {   44,   52,   47, 0x22 },
+    {   46,   54,   49, 0x44 },
+    {   48,   56,   51, 0x44 },
+    {   50,   57,   53, 0x08 },
+    {   52,   59,   55, 0x08 },
+  } },
+  {  2,  1, {
+    {   40,   47,   43, 0x10 },
+    {   41,   49,   44, 0x21 },
+    {   43,   51,   46, 0x42 },
+    {   45,   52,   48, 0x04 },
+    {   47,   54,   50, 0x08 },
+    {   48,   56,   51, 0x11 },
+    {   50,   58,   53, 0x21 },
+    {   52,   60,   55, 0x42 },
+  } },
+  {  1,  1, {
+    {   42,   49,   45, 0x08 },
+    {   43,   51,   46, 0x21 },
+    {   45,   52,   48, 0x04 },
+    {   47,   54,   50, 0x10 },
+    {   48,   56,   51, 0x42 },
+    {   50,   57,   53, 0x08 },
+    {   52,   59,   55, 0x10 },
+    {   53,   61,   56, 0x42 },
+  } },
+  {  1,  1, {
+    {   43,   50,   46, 0x08 },
+    {   44,   52,   47, 0x41 },
+    {   46,   53,   49, 0x08 },
+    {   47,   55,   50, 0x21 },
+    {   49,   56,   52, 0x04 },
+    {   50,   58,   53, 0x21 },
+    {   52,   59,   55, 0x04 },
+    {   54,   61,   57, 0x20 },
+  } },
+  {  1,  1, {
+    {   44,   51,   47, 0x08 },
+    {   45,   53,   48, 0x42 },
+    {   47,   54,   50, 0x10 },
+    {   48,   55,   51, 0x02 },
+    {   50,   57,   53, 0x10 },
+    {   51,   58,   54, 0x04 },
+    {   53,   60,   56, 0x20 },
+    {   54,   61,   57, 0x08 },
+  } },
+  {  1,  1, {
+    {   45,   52,   48, 0x08 },
+    {   46,   53,   49, 0x02 },
+    {   48,   55,   51, 0x20 },
+    {   49,   56,   52, 0x08 },
+    {   50,   57,   53, 0x02 },
+    {   52,   59,   55, 0x20 },
+    {   53,   60,   56, 0x04 },
+    {   54,   62,   57, 0x41 },
+  } },
+  {  1,  1, {
+    {   46,   53,   49, 0x10 },
+    {   47,   54,   50, 0x04 },
+    {   48,   56,   51, 0x41 },
+    {   50,   57,   53, 0x20 },
+    {   51,   58,   54, 0x08 },
+    {   52,   59,   55, 0x02 },
+    {   54,   61,   57, 0x40 },
+    {   55,   62,   58, 0x10 },
+  } },
+  {  0,  1, {
+    {   47,   54,   50, 0x08 },
+    {   48,   55,   51, 0x04 },
+    {   49,   56,   52, 0x02 },
+    {   51,   58,   54, 0x40 },
+    {   52,   59,   55, 0x20 },
+    {   53,   60,   56, 0x10 },
+    {   54,   61,   57, 0x08 },
+    {   55,   62,   58, 0x04 },
+  } },
+  {  0,  1, {
+    {   48,   55,   51, 0x08 },
+    {   49,   56,   52, 0x08 },
+    {   50,   57,   53, 0x04 },
+    {   51,   58,   54, 0x02 },
+    {   52,   59,   55, 0x02 },
+    {   53,   60,   56, 0x01 },
+    {   55,   61,   58, 0x00 },
+    {   56,   63,   59, 0x40 },
+  } },
+  {  0,  1, {
+    {   49,   56,   52, 0x08 },
+    {   50,   57,   53, 0x08 },
+    {   51,   58,   54, 0x08 },
+    {   52,   59,   55, 0x08 },
+    {   53,   60,   56, 0x08 },
+    {   54,   61,   57, 0x08 },
+    {   55,   62,   58, 0x08 },
+    {   56,   63,   59, 0x08 },
+  } },
+  {  0,  1, {
+    {   50,   57,   53, 0x10 },
+    {   51,   58,   54, 0x20 },
+    {   52,   59,   55, 0x20 },
+    {   53,   60,   56, 0x40 },
+    {   54,   60,   57, 0x00 },
+    {   55,   61,   58, 0x00 },
+    {   56,   62,   59, 0x00 },
+    {   56,   63,   59, 0x01 },
+  } },
+  {  0,  1, {
+    {   51,   58,   54, 0x10 },
+    {   52,   59,   55, 0x40 },
+    {   53,   59,   56, 0x00 },
+    {   54,   60,   57, 0x00 },
+    {   54,   61,   57, 0x02 },
+    {   55,   62,   58, 0x08 },
+    {   56,   63,   59, 0x10 },
+    {   57,   64,   60, 0x40 },
+  } },
+  {  0,  1, {
+    {   52,   59,   55, 0x20 },
+    {   53,   59,   56, 0x00 },
+    {   54,   60,   57, 0x00 },
+    {   54,   61,   57, 0x04 },
+    {   55,   62,   58, 0x20 },
+    {   56,   62,   59, 0x00 },
+    {   57,   63,   60, 0x00 },
+    {   57,   64,   60, 0x04 },
+  } },
+  {  0,  1, {
+    {   53,   60,   56, 0x20 },
+    {   54,   60,   57, 0x00 },
+    {   54,   61,   57, 0x02 },
+    {   55,   62,   58, 0x20 },
+    {   56,   62,   59, 0x00 },
+    {   56,   63,   59, 0x02 },
+    {   57,   64,   60, 0x20 },
+    {   58,   64,   61, 0x00 },
+  } },
+  {  0,  1, {
+    {   54,   61,   57, 0x40 },
+    {   55,   61,   58, 0x00 },
+    {   55,   62,   58, 0x10 },
+    {   56,   62,   59, 0x00 },
+    {   56,   63,   59, 0x04 },
+    {   57,   63,   60, 0x00 },
+    {   58,   64,   61, 0x00 },
+    {   58,   65,   61, 0x20 },
+  } },
+  {  0,  1, {
+    {   56,   62,   59, 0x00 },
+    {   56,   63,   59, 0x02 },
+    {   57,   63,   60, 0x00 },
+    {   57,   64,   60, 0x10 },
+    {   58,   64,   61, 0x00 },
+    {   58,   64,   61, 0x00 },
+    {   59,   65,   62, 0x00 },
+    {   59,   65,   62, 0x00 },
+  } },
+  {  0,  1, {
+    {   57,   63,   60, 0x00 },
+    {   57,   64,   60, 0x08 },
+    {   58,   64,   61, 0x00 },
+    {   58,   64,   61, 0x00 },
+    {   58,   65,   61, 0x08 },
+    {   59,   65,   62, 0x00 },
+    {   59,   65,   62, 0x00 },
+    {   59,   66,   62, 0x08 },
+  } },
+  {  0,  1, {
+    {   58,   64,   61, 0x00 },
+    {   58,   64,   61, 0x00 },
+    {   59,   65,   62, 0x00 },
+    {   59,   65,   62, 0x00 },
+    {   59,   65,   62, 0x00 },
+    {   59,   65,   62, 0x00 },
+    {   60,   66,   63, 0x00 },
+    {   60,   66,   63, 0x00 },
+  } },
+  {  0,  1, {
+    {   59,   65,   62, 0x00 },
+    {   59,   65,   62, 0x00 },
+    {   59,   65,   62, 0x00 },
+    {   60,   66,   63, 0x00 },
+    {   60,   66,   63, 0x00 },
+    {   60,   66,   63, 0x00 },
+    {   60,   66,   63, 0x00 },
+    {   60,   66,   63, 0x00 },
+  } },
+  {  0,  1, {
+    {   60,   66,   63, 0x00 },
+    {   60,   66,   63, 0x00 },
+    {   60,   66,   63, 0x00 },
+    {   60,   66,   63, 0x00 },
+    {   60,   66,   63, 0x00 },
+    {   60,   66,   63, 0x00 },
+    {   61,   67,   64, 0x00 },
+    {   61,   67,   64, 0x00 },
+  } },
+  {  0, -1, {
+    {   61,   67,   64, 0x00 },
+    {   61,   67,   64, 0x00 },
+    {   61,   67,   64, 0x00 },
+    {   61,   67,   64, 0x00 },
+    {   61,   67,   64, 0x00 },
+    {   61,   67,   64, 0x00 },
+    {   61,   67,   64, 0x00 },
+    {   61,   67,   64, 0x00 },
+  } },
+  {  0, -1, {
+    {   62,   68,   65, 0x00 },
+    {   62,   68,   65, 0x00 },
+    {   62,   68,   65, 0x00 },
+    {   62,   68,   65, 0x00 },
+    {   62,   68,   65, 0x00 },
+    {   62,   68,   65, 0x00 },
+    {   61,   67,   64, 0x00 },
+    {   61,   67,   64, 0x00 },
+  } },
+  {  0, -1, {
+    {   63,   69,   66, 0x00 },
+    {   63,   69,   66, 0x00 },
+    {   63,   69,   66, 0x00 },
+    {   62,   68,   65, 0x00 },
+    {   62,   68,   65, 0x00 },
+    {   62,   68,   65, 0x00 },
+    {   62,   68,   65, 0x00 },
+    {   62,   68,   65, 0x00 },
+  } },
+  {  0, -1, {
+    {   64,   70,   67, 0x00 },
+    {   64,   70,   67, 0x00 },
+    {   63,   69,   66, 0x00 },
+    {   63,   69,   66, 0x00 },
+    {   63,   69,   66, 0x00 },
+    {   63,   69,   66, 0x00 },
+    {   62,   68,   65, 0x00 },
+    {   62,   68,   65, 0x00 },
+  } },
+  {  0, -1, {
+    {   65,   71,   68, 0x00 },
+    {   64,   71,   68, 0x08 },
+    {   64,   70,   67, 0x00 },
+    {   64,   70,   67, 0x00 },
+    {   63,   70,   67, 0x08 },
+    {   63,   69,   66, 0x00 },
+    {   63,   69,   66, 0x00 },
+    {   62,   69,   66, 0x08 },
+  } },
+  {  0, -1, {
+    {   67,   73,   70, 0x00 },
+    {   66,   72,   69, 0x00 },
+    {   66,   72,   69, 0x00 },
+    {   65,   71,   68, 0x00 },
+    {   65,   71,   68, 0x00 },
+    {   64,   70,   67, 0x00 },
+    {   64,   70,   67, 0x00 },
+    {   63,   69,   66, 0x00 },
+  } },
+  {  0, -1, {
+    {   67,   74,   71, 0x40 },
+    {   67,   73,   70, 0x00 },
+    {   66,   73,   70, 0x10 },
+    {   66,   72,   69, 0x00 },
+    {   65,   72,   69, 0x04 },
+    {   65,   71,   68, 0x00 },
+    {   64,   70,   67, 0x00 },
+    {   63,   70,   67, 0x20 },
+  } },
+  {  0, -1, {
+    {   68,   75,   72, 0x20 },
+    {   68,   74,   71, 0x00 },
+    {   67,   74,   71, 0x02 },
+    {   66,   73,   70, 0x20 },
+    {   66,   72,   69, 0x00 },
+    {   65,   72,   69, 0x02 },
+    {   64,   71,   68, 0x20 },
+    {   64,   70,   67, 0x00 },
+  } },
+  {  0, -1, {
+    {   69,   76,   73, 0x20 },
+    {   69,   75,   72, 0x00 },
+    {   68,   74,   71, 0x00 },
+    {   67,   74,   71, 0x04 },
+    {   66,   73,   70, 0x20 },
+    {   66,   72,   69, 0x00 },
+    {   65,   71,   68, 0x00 },
+    {   64,   71,   68, 0x04 },
+  } },
+  {  0, -1, {
+    {   70,   77,   74, 0x10 },
+    {   69,   76,   73, 0x40 },
+    {   69,   75,   72, 0x00 },
+    {   68,   74,   71, 0x00 },
+    {   67,   74,   71, 0x02 },
+    {   66,   73,   70, 0x08 },
+    {   65,   72,   69, 0x10 },
+    {   64,   71,   68, 0x40 },
+  } },
+  {  0, -1, {
+    {   71,   78,   75, 0x10 },
+    {   70,   77,   74, 0x20 },
+    {   69,   76,   73, 0x20 },
+    {   68,   75,   72, 0x40 },
+    {   68,   74,   71, 0x00 },
+    {   67,   73,   70, 0x00 },
+    {   66,   72,   69, 0x00 },
+    {   65,   72,   69, 0x01 },
+  } },
+  {  0, -1, {
+    {   72,   79,   76, 0x08 },
+    {   71,   78,   75, 0x08 },
+    {   70,   77,   74, 0x08 },
+    {   69,   76,   73, 0x08 },
+    {   68,   75,   72, 0x08 },
+    {   67,   74,   71, 0x08 },
+    {   66,   73,   70, 0x08 },
+    {   65,   72,   69, 0x08 },
+  } },
+  {  0, -1, {
+    {   73,   80,   77, 0x08 },
+    {   72,   79,   76, 0x08 },
+    {   71,   78,   75, 0x04 },
+    {   70,   77,   74, 0x02 },
+    {   69,   76,   73, 0x02 },
+    {   68,   75,   72, 0x01 },
+    {   67,   73,   70, 0x00 },
+    {   65,   72,   69, 0x40 },
+  } },
+  {  1, -1, {
+    {   74,   81,   78, 0x10 },
+    {   73,   80,   77, 0x08 },
+    {   72,   79,   76, 0x02 },
+    {   71,   78,   75, 0x01 },
+    {   69,   76,   73, 0x20 },
+    {   68,   75,   72, 0x10 },
+    {   67,   74,   71, 0x08 },
+    {   66,   73,   70, 0x04 },
+  } },
+  {  1, -1, {
+    {   75,   82,   79, 0x10 },
+    {   74,   81,   78, 0x04 },
+    {   72,   80,   77, 0x41 },
+    {   71,   78,   75, 0x20 },
+    {   70,   77,   74, 0x08 },
+    {   69,   76,   73, 0x02 },
+    {   67,   74,   71, 0x40 },
+    {   66,   73,   70, 0x10 },
+  } },
+  {  1, -1, {
+    {   76,   83,   80, 0x08 },
+    {   75,   82,   79, 0x02 },
+    {   73,   80,   77, 0x20 },
+    {   72,   79,   76, 0x08 },
+    {   71,   78,   75, 0x02 },
+    {   69,   76,   73, 0x20 },
+    {   68,   75,   72, 0x04 },
+    {   66,   74,   71, 0x41 },
+  } },
+  {  1, -1, {
+    {   77,   84,   81, 0x08 },
+    {   75,   83,   80, 0x42 },
+    {   74,   81,   78, 0x10 },
+    {   73,   80,   77, 0x02 },
+    {   71,   78,   75, 0x10 },
+    {   70,   77,   74, 0x04 },
+    {   68,   75,   72, 0x20 },
+    {   67,   74,   71, 0x08 },
+  } },
+  {  1, -1, {
+    {   78,   85,   82, 0x08 },
+    {   76,   84,   81, 0x41 },
+    {   75,   82,   79, 0x08 },
+    {   73,   81,   78, 0x21 },
+    {   72,   79,   76, 0x04 },
+    {   70,   78,   75, 0x21 },
+    {   69,   76,   73, 0x04 },
+    {   67,   74,   71, 0x20 },
+  } },
+  {  2, -1, {
+    {   80,   87,   84, 0x10 },
+    {   78,   86,   83, 0x22 },
+    {   77,   84,   81, 0x04 },
+    {   75,   82,   79, 0x08 },
+    {   73,   81,   78, 0x21 },
+    {   71,   79,   76, 0x42 },
+    {   70,   77,   74, 0x08 },
+    {   68,   76,   73, 0x11 },
+  } },
+  {  2, -1, {
+    {   81,   88,   85, 0x10 },
+    {   79,   87,   84, 0x21 },
+    {   77,   85,   82, 0x42 },
+    {   76,   83,   80, 0x04 },
+    {   74,   81,   78, 0x08 },
+    {   72,   80,   77, 0x11 },
+    {   70,   78,   75, 0x21 },
+    {   68,   76,   73, 0x42 },
+  } },
+  {  2, -1, {
+    {   82,   89,   86, 0x10 },
+    {   80,   88,   85, 0x11 },
+    {   78,   86,   83, 0x21 },
+    {   76,   84,   81, 0x22 },
+    {   74,   82,   79, 0x44 },
+    {   72,   80,   77, 0x44 },
+    {   71,   78,   75, 0x08 },
+    {   69,   76,   73, 0x08 },
+  } },
+  {  2, -1, {
+    {   83,   90,   87, 0x10 },
+    {   81,   89,   86, 0x11 },
+    {   79,   87,   84, 0x11 },
+    {   77,   85,   82, 0x11 },
+    {   75,   83,   80, 0x11 },
+    {   73,   81,   78, 0x11 },
+    {   71,   79,   76, 0x21 },
+    {   69,   77,   74, 0x22 },
+  } },
+  {  3, -1, {
+    {   84,   91,   88, 0x10 },
+    {   82,   90,   87, 0x11 },
+    {   80,   88,   85, 0x11 },
+    {   78,   86,   83, 0x09 },
+    {   76,   83,   80, 0x08 },
+    {   74,   81,   78, 0x08 },
+    {   71,   79,   76, 0x44 },
+    {   69,   77,   74, 0x44 },
+  } },
+  {  3, -1, {
+    {   85,   92,   89, 0x10 },
+    {   83,   91,   88, 0x11 },
+    {   81,   88,   85, 0x08 },
+    {   78,   86,   83, 0x44 },
+    {   76,   84,   81, 0x24 },
+    {   74,   82,   79, 0x22 },
+    {   72,   80,   77, 0x11 },
+    {   70,   78,   75, 0x11 },
+  } },
+  {  3, -1, {
+    {   86,   93,   90, 0x10 },
+    {   84,   92,   89, 0x09 },
+    {   81,   89,   86, 0x44 },
+    {   79,   87,   84, 0x22 },
+    {   77,   85,   82, 0x12 },
+    {   75,   83,   80, 0x09 },
+    {   72,   80,   77, 0x44 },
+    {   70,   78,   75, 0x22 },
+  } },
+  {  4, -1, {
+    {   87,   94,   91, 0x20 },
+    {   85,   93,   90, 0x12 },
+    {   82,   90,   87, 0x48 },
+    {   80,   88,   85, 0x24 },
+    {   78,   86,   83, 0x11 },
+    {   75,   83,   80, 0x48 },
+    {   73,   81,   78, 0x22 },
+    {   71,   79,   76, 0x11 },
+  } },
+  {  4, -1, {
+    {   88,   95,   92, 0x20 },
+    {   86,   94,   91, 0x11 },
+    {   83,   91,   88, 0x44 },
+    {   81,   89,   86, 0x12 },
+    {   78,   86,   83, 0x48 },
+    {   76,   84,   81, 0x22 },
+    {   73,   82,   79, 0x49 },
+    {   71,   79,   76, 0x24 },
+  } },
+  {  4, -1, {
+    {   89,   96,   93, 0x20 },
+    {   87,   95,   92, 0x09 },
+    {   84,   92,   89, 0x24 },
+    {   81,   90,   87, 0x49 },
+    {   79,   87,   84, 0x24 },
+    {   76,   85,   82, 0x49 },
+    {   74,   82,   79, 0x22 },
+    {   71,   80,   77, 0x49 },
+  } },
+  {  5, -1, {
+    {   90,   97,   94, 0x40 },
+    {   88,   96,   93, 0x12 },
+    {   85,   93,   90, 0x24 },
+    {   82,   91,   88, 0x49 },
+    {   80,   88,   85, 0x12 },
+    {   77,   85,   82, 0x24 },
+    {   74,   83,   80, 0x49 },
+    {   72,   80,   77, 0x12 },
+  } },
+  {  5, -1, {
+    {   91,   98,   95, 0x40 },
+    {   89,   97,   94, 0x12 },
+    {   86,   94,   91, 0x14 },
+    {   83,   91,   88, 0x24 },
+    {   80,   89,   86, 0x49 },
+    {   78,   86,   83, 0x12 },
+    {   75,   83,   80, 0x12 },
+    {   72,   80,   77, 0x24 },
+  } },
+  {  5, -1, {
+    {   92,   99,   96, 0x40 },
+    {   89,   98,   95, 0x52 },
+    {   87,   95,   92, 0x12 },
+    {   84,   92,   89, 0x14 },
+    {   81,   89,   86, 0x24 },
+    {   78,   87,   84, 0x25 },
+    {   75,   84,   81, 0x49 },
+    {   72,   81,   78, 0x4a },
+  } },
+  {  6, -1, {
+    {   94,  100,   97, 0x00 },
+    {   91,   99,   96, 0x14 },
+    {   88,   96,   93, 0x14 },
+    {   85,   93,   90, 0x24 },
+    {   82,   90,   87, 0x24 },
+    {   79,   88,   85, 0x25 },
+    {   76,   85,   82, 0x25 },
+    {   73,   82,   79, 0x29 },
+  } },
+  {  6, -1, {
+    {   95,  101,   98, 0x00 },
+    {   92,  100,   97, 0x12 },
+    {   89,   97,   94, 0x12 },
+    {   86,   94,   91, 0x12 },
+    {   83,   91,   88, 0x12 },
+    {   80,   88,   85, 0x12 },
+    {   76,   85,   82, 0x52 },
+    {   73,   82,   79, 0x52 },
+  } },
+  {  6, -1, {
+    {   96,  102,   99, 0x00 },
+    {   92,  101,   98, 0x52 },
+    {   89,   98,   95, 0x52 },
+    {   86,   95,   92, 0x4a },
+    {   83,   92,   89, 0x49 },
+    {   80,   89,   86, 0x29 },
+    {   77,   86,   83, 0x25 },
+    {   74,   83,   80, 0x25 },
+  } },
+  {  7, -1, {
+    {   97,  103,  100, 0x00 },
+    {   94,  103,  100, 0x25 },
+    {   90,   99,   96, 0x52 },
+    {   87,   96,   93, 0x4a },
+    {   84,   93,   90, 0x29 },
+    {   81,   89,   86, 0x14 },
+    {   77,   86,   83, 0x52 },
+    {   74,   83,   80, 0x2a },
+  } },
+  {  7, -1, {
+    {   98,  104,  101, 0x00 },
+    {   95,  104,  101, 0x15 },
+    {   91,  100,   97, 0x52 },
+    {   88,   97,   94, 0x29 },
+    {   85,   93,   90, 0x14 },
+    {   81,   90,   87, 0x4a },
+    {   78,   87,   84, 0x25 },
+    {   74,   83,   80, 0x54 },
+  } },
+  {  8, -1, {
+    { -128, -128, -128, 0x00 },
+    {   96,  105,  102, 0x2a },
+    {   93,  102,   99, 0x15 },
+    {   89,   98,   95, 0x2a },
+    {   86,   95,   92, 0x15 },
+    {   82,   91,   88, 0x4a },
+    {   79,   88,   85, 0x25 },
+    {   75,   84,   81, 0x52 },
+  } },
+  {  8, -1, {
+    { -128, -128, -128, 0x00 },
+    {   97,  106,  103, 0x2a },
+    {   93,  102,   99, 0x54 },
+    {   90,   99,   96, 0x29 },
+    {   86,   95,   92, 0x52 },
+    {   83,   92,   89, 0x25 },
+    {   79,   88,   85, 0x4a },
+    {   76,   85,   82, 0x25 },
+  } },
+  {  9, -1, {
+    { -128, -128, -128, 0x00 },
+    {   98,  107,  104, 0x54 },
+    {   94,  104,  101, 0x55 },
+    {   91,  100,   97, 0x2a },
+    {   87,   96,   93, 0x4a },
+    {   83,   93,   90, 0x55 },
+    {   80,   89,   86, 0x25 },
+    {   76,   85,   82, 0x2a },
+  } },
+  {  9, -1, {
+    { -128, -128, -128, 0x00 },
+    {   99,  108,  105, 0x54 },
+    {   95,  105,  102, 0x55 },
+    {   92,  101,   98, 0x15 },
+    {   88,   97,   94, 0x2a },
+    {   84,   93,   90, 0x2a },
+    {   80,   89,   86, 0x4a },
+    {   76,   86,   83, 0x55 },
+  } },
+  { 10, -1, {
+    { -128, -128, -128, 0x00 },
+    {  101,  109,  106, 0x28 },
+    {   97,  106,  103, 0x2a },
+    {   93,  102,   99, 0x2a },
+    {   89,   98,   95, 0x2a },
+    {   85,   94,   91, 0x2a },
+    {   81,   90,   87, 0x4a },
+    {   77,   87,   84, 0x55 },
+  } },
+  { 10, -1, {
+    { -128, -128, -128, 0x00 },
+    {  101,  110,  107, 0x54 },
+    {   97,  107,  104, 0x55 },
+    {   93,  103,  100, 0x55 },
+    {   89,   99,   96, 0x55 },
+    {   85,   95,   92, 0x55 },
+    {   81,   91,   88, 0x55 },
+    {   77,   87,   84, 0x55 },
+  } },
+  { 11, -1, {
+    { -128, -128, -128, 0x00 },
+    {  103,  111,  108, 0x28 },
+    {   99,  108,  105, 0x2a },
+    {   95,  104,  101, 0x2a },
+    {   90,  100,   97, 0x55 },
+    {   86,   96,   93, 0x55 },
+    {   82,   92,   89, 0x35 },
+    {   78,   87,   84, 0x2a },
+  } },
+  { 11, -1, {
+    { -128, -128, -128, 0x00 },
+    {  104,  112,  109, 0x28 },
+    {  100,  109,  106, 0x2a },
+    {   95,  105,  102, 0x55 },
+    {   91,  101,   98, 0x55 },
+    {   87,   96,   93, 0x2a },
+    {   82,   92,   89, 0x5a },
+    {   78,   88,   85, 0x55 },
+  } },
+  { 12, -1, {
+    { -128, -128, -128, 0x00 },
+    {  105,  113,  110, 0x50 },
+    {  101,  111,  108, 0x55 },
+    {   97,  106,  103, 0x2a },
+    {   92,  102,   99, 0x55 },
+    {   88,   98,   95, 0x2d },
+    {   83,   93,   90, 0x6a },
+    {   79,   89,   86, 0x55 },
+  } },
+  { 12, -1, {
+    { -128, -128, -128, 0x00 },
+    {  106,  114,  111, 0x50 },
+    {  102,  112,  109, 0x35 },
+    {   97,  107,  104, 0x5a },
+    {   93,  103,  100, 0x35 },
+    {   88,   98,   95, 0x6a },
+    {   84,   94,   91, 0x35 },
+    {   79,   89,   86, 0x6a },
+  } },
+  { 13, -1, {
+    { -128, -128, -128, 0x00 },
+    {  108,  115,  112, 0x20 },
+    {  103,  113,  110, 0x56 },
+    {   98,  109,  106, 0x6b },
+    {   94,  104,  101, 0x35 },
+    {   89,   99,   96, 0x56 },
+    {   84,   95,   92, 0x6b },
+    {   80,   90,   87, 0x2d },
+  } },
+  { 13, -1, {
+    { -128, -128, -128, 0x00 },
+    {  109,  116,  113, 0x20 },
+    {  104,  114,  111, 0x56 },
+    {   99,  109,  106, 0x5a },
+    {   94,  105,  102, 0x6b },
+    {   90,  100,   97, 0x2d },
+    {   85,   95,   92, 0x35 },
+    {   80,   90,   87, 0x5a },
+  } },
+  { 14, -1, {
+    { -128, -128, -128, 0x00 },
+    {  110,  117,  114, 0x40 },
+    {  106,  116,  113, 0x2d },
+    {  101,  111,  108, 0x2d },
+    {   96,  106,  103, 0x35 },
+    {   91,  101,   98, 0x36 },
+    {   86,   96,   93, 0x56 },
+    {   81,   91,   88, 0x5a },
+  } },
+  { 14, -1, {
+    { -128, -128, -128, 0x00 },
+    {  111,  118,  115, 0x40 },
+    {  106,  117,  114, 0x6d },
+    {  101,  112,  109, 0x6d },
+    {   96,  107,  104, 0x6d },
+    {   91,  102,   99, 0x6d },
+    {   86,   97,   94, 0x6d },
+    {   82,   92,   89, 0x2d },
+  } },
+  { 15, -1, {
+    { -128, -128, -128, 0x00 },
+    {  113,  119,  116, 0x00 },
+    {  108,  118,  115, 0x36 },
+    {  103,  113,  110, 0x35 },
+    {   97,  108,  105, 0x6d },
+    {   92,  103,  100, 0x5b },
+    {   87,   98,   95, 0x5b },
+    {   82,   92,   89, 0x36 },
+  } },
+  { 16, -1, {
+    { -128, -128, -128, 0x00 },
+    { -128, -128, -128, 0x00 },
+    {  109,  120,  117, 0x6d },
+    {  104,  115,  112, 0x5b },
+    {   99,  109,  106, 0x36 },
+    {   93,  104,  101, 0x6d },
+    {   88,   99,   96, 0x5b },
+    {   83,   93,   90, 0x5a },
+  } },
+  { 16, -1, {
+    { -128, -128, -128, 0x00 },
+    { -128, -128, -128, 0x00 },
+    {  109,  120,  117, 0x6d },
+    {  104,  115,  112, 0x5b },
+    {   99,  109,  106, 0x36 },
+    {   93,  104,  101, 0x6d },
+    {   88,   99,   96, 0x5b },
+    {   83,   93,   90, 0x5a },
+  } },
+  { 17, -1, {
+    { -128, -128, -128, 0x00 },
+    { -128, -128, -128, 0x00 },
+    {  111,  121,  118, 0x5a },
+    {  105,  116,  113, 0x6d },
+    {  100,  111,  108, 0x3b },
+    {   94,  105,  102, 0x6d },
+    {   89,  100,   97, 0x37 },
+    {   83,   94,   91, 0x6d },
+  } },
+  { 17, -1, {
+    { -128, -128, -128, 0x00 },
+    { -128, -128, -128, 0x00 },
+    {  112,  122,  119, 0x3a },
+    {  106,  117,  114, 0x6d },
+    {  100,  111,  108, 0x76 },
+    {   95,  106,  103, 0x5b },
+    {   89,  100,   97, 0x6d },
+    {   84,   94,   91, 0x36 },
+  } },
+  { 18, -1, {
+    { -128, -128, -128, 0x00 },
+    { -128, -128, -128, 0x00 },
+    {  113,  123,  120, 0x74 },
+    {  108,  119,  116, 0x3b },
+    {  102,  113,  110, 0x5d },
+    {   96,  107,  104, 0x6d },
+    {   90,  101,   98, 0x76 },
+    {   85,   96,   93, 0x3b },
+  } },
+  { 19, -1, {
+    { -128, -128, -128, 0x00 },
+    { -128, -128, -128, 0x00 },
+    {  115,  124,  121, 0x58 },
+    {  109,  120,  117, 0x5d },
+    {  103,  114,  111, 0x5d },
+    {   97,  108,  105, 0x5d },
+    {   91,  102,   99, 0x5d },
+    {   85,   96,   93, 0x5d },
+  } },
+  { 19, -1, {
+    { -128, -128, -128, 0x00 },
+    { -128, -128, -128, 0x00 },
+    {  116,  125,  122, 0x58 },
+    {  110,  121,  118, 0x5d },
+    {  104,  115,  112, 0x3d },
+    {   98,  109,  106, 0x3b },
+    {   92,  103,  100, 0x3b },
+    {   85,   97,   94, 0x77 },
+  } },
+  { 20, -1, {
+    { -128, -128, -128, 0x00 },
+    { -128, -128, -128, 0x00 },
+    {  118,  126,  123, 0x30 },
+    {  111,  123,  120, 0x7b },
+    {  105,  117,  114, 0x77 },
+    {   99,  110,  107, 0x6e },
+    {   93,  104,  101, 0x5d },
+    {   87,   98,   95, 0x3b },
+  } },
+  { 21, -1, {
+    { -128, -128, -128, 0x00 },
+    { -128, -128, -128, 0x00 },
+    {  119,  127,  124, 0x60 },
+    {  113,  125,  122, 0x6f },
+    {  106,  118,  115, 0x7b },
+    {  100,  112,  109, 0x6f },
+    {   93,  105,  102, 0x7b },
+    {   87,   99,   96, 0x6f },
+  } },
+  { 21, -1, {
+    { -128, -128, -128, 0x00 },
+    { -128, -128, -128, 0x00 },
+    {  119,  127,  124, 0x60 },
+    {  113,  125,  122, 0x6f },
+    {  106,  118,  115, 0x7b },
+    {  100,  112,  109, 0x6f },
+    {   93,  105,  102, 0x7b },
+    {   87,   99,   96, 0x6f },
+  } },
+  { 22, -1, {
+    { -128, -128, -128, 0x00 },
+    { -128, -128, -128, 0x00 },
+    {  121,  127,  125, 0x40 },
+    {  115,  126,  123, 0x3e },
+    {  108,  120,  117, 0x6f },
+    {  101,  113,  110, 0x7d },
+    {   95,  107,  104, 0x5f },
+    {   88,  100,   97, 0x77 },
+  } },
+  { 23, -1, {
+    { -128, -128, -128, 0x00 },
+    { -128, -128, -128, 0x00 },
+    {  123,  127,  126, 0x00 },
+    {  116,  127,  125, 0x7b },
+    {  109,  121,  118, 0x7d },
+    {  102,  114,  111, 0x7d },
+    {   95,  107,  104, 0x7e },
+    {   89,  101,   98, 0x3f },
+  } },
+  { 23, -1, {
+    { -128, -128, -128, 0x00 },
+    { -128, -128, -128, 0x00 },
+    {  124,  127,  127, 0x00 },
+    {  117,  127,  126, 0x77 },
+    {  110,  122,  119, 0x77 },
+    {  103,  115,  112, 0x77 },
+    {   96,  108,  105, 0x77 },
+    {   89,  101,   98, 0x77 },
+  } },
+};
@@ -3,6 +3,7 @@
 
 #include <stdint.h>
 #include "config.h"
+#include "ssd1306.h"
 
 
 #define NEEDLE_AXIS_X (64)
@@ -15,6 +16,21 @@ typedef struct needle_coordinates_t_ {
 } needle_coordinates_t;
 
 
+typedef struct needle_page_raster_t_ {
+  int8_t start_column; /* including shadow, -128 if needle doesn't reach the page */
+  int8_t end_column;
+  int8_t column; /* in the first row of the page covered by needle */
+  uint8_t steps; /* bit n is set if column changes after n-th row of the page */
+} needle_page_raster_t;
+
+typedef struct needle_raster_t_ {
+  uint8_t tip_row;
+  int8_t step;
+  needle_page_raster_t pages[SSD1306_PAGES_N];
+} needle_raster_t;
+
+
 extern const needle_coordinates_t NEEDLE_COORDINATES[NEEDLE_RESOLUTION];
+extern const needle_raster_t NEEDLE_RASTERS[NEEDLE_RESOLUTION];
 
 #endif /* NEEDLE_COORDINATES_H */
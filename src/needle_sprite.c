@@ -8,149 +8,67 @@
 #include "ssd1306.h"
 
 
-static void
-draw_line_23_octants(int8_t buffer[], uint8_t ax, uint8_t ay, uint8_t bx, uint8_t by)
-{
-  int8_t error = 0;
-  int8_t delta_err = abs(bx - ax);
-  int8_t error_threshold = (by - ay) / 2;
-  int8_t delta_x = (bx > ax) ? 1 : -1;
-  int8_t y;
-
-  for (y = 0; y < ay; ++y) {
-    buffer[y] = -128;
-  }
-
-  for (int8_t y = ay, x = ax; y <= by && y < SSD1306_HEIGHT; ++y) {
-    buffer[y] = x;
-    error += delta_err;
+extern inline void needle_sprite_render(sprite_t *sprite, uint8_t column_a, uint8_t page,
+  uint8_t column_b, ssd1306_segment_t* segments);
 
-    if (error >= error_threshold) {
-      x += delta_x;
-      error -= error_threshold * 2;
-    }
-  }
 
-  for (y = by + 1; y < SSD1306_HEIGHT; ++y) {
-    buffer[y] = -128;
-  }
-}
-
-static void
-needle_sprite_render_cb(sprite_t *sprite, uint8_t column_a, uint8_t page, uint8_t column_b, ssd1306_segment_t* segments)
+void
+needle_sprite_init(needle_sprite_t *needle)
 {
-  needle_sprite_t *needle = (needle_sprite_t *) sprite;
-
-  int8_t start_column = needle->start_column[page];
-  int8_t end_column = needle->end_column[page];
-
-  if (start_column == -128) {
-    return;
-  }
-
-  start_column = int_max(start_column, column_a);
-  end_column = int_min(end_column, column_b);
-
-  for (uint8_t column = start_column; column <= end_column; ++column) {
-    uint8_t segment = segments[column - column_a];
-
-    for (uint8_t i = 0; i < 8; ++i) {
-      uint8_t row = page * 8 + i;
-
-      if (needle->column[row] < 0) {
-        continue;
-      }
-
-      uint8_t bit = 1 << i;
-      int8_t d = needle->column[row] - column;
-
-      if (d < 0) d = -d; /* Add `- 1` for double width */
+  sprite_init(&(needle->sprite), needle_sprite_render);
+  needle->raster = &(NEEDLE_RASTERS[0]);
+}
 
-      if (d == 0) {
-        segment |= bit;
-      }
-      else if (d <= 2) {
-        segment &= ~bit;
-      }
-    }
 
-    segments[column - column_a] = segment;
-  }
+uint8_t
+needle_angle_to_index(uint8_t angle)
+{
+  return (uint16_t) angle * NEEDLE_RESOLUTION / 256;
 }
 
 
-void
-needle_sprite_init(needle_sprite_t *needle)
+uint8_t
+needle_sprite_get_index(needle_sprite_t *needle)
 {
-  needle->sprite.render = needle_sprite_render_cb;
-  needle->sprite.visible = true;
-  memset(needle->column, -128, sizeof(needle->column));
+  return needle->raster - NEEDLE_RASTERS;
 }
 
 
 void
 needle_sprite_draw(needle_sprite_t *needle, uint8_t angle)
 {
-  uint8_t index = (uint16_t) angle * NEEDLE_RESOLUTION / 256;
-  uint8_t ax = pgm_read_byte(&(NEEDLE_COORDINATES[index].x));
-  uint8_t ay = pgm_read_byte(&(NEEDLE_COORDINATES[index].y));
-
-  draw_line_23_octants(needle->column, ax, ay, NEEDLE_AXIS_X, NEEDLE_AXIS_Y);
+  needle_sprite_draw_index(needle, needle_angle_to_index(angle));
+}
 
-  uint8_t page = 0;
 
-  /* Pages over the needle */
-  for (; page < ay / SSD1306_PAGE_HEIGHT; ++page) {
-    needle->start_column[page] = -128;
-    needle->end_column[page] = -128;
-  }
+void
+needle_sprite_draw_index(needle_sprite_t *needle, uint8_t index)
+{
+  assert(index < NEEDLE_RESOLUTION);
 
-  /* Page, where the needle has it's tip */
-  if (ax <= NEEDLE_AXIS_X) {
-    needle->start_column[page] = ax;
-    needle->end_column[page] = needle->column[(page + 1) * SSD1306_PAGE_HEIGHT - 1];
-  }
-  else {
-    needle->start_column[page] = needle->column[(page + 1) * SSD1306_PAGE_HEIGHT - 1];
-    needle->end_column[page] = ax;
-  }
+  /* Needle is rasterized at build time, see calculate_needle_coordinates.py */
+  needle->raster = &(NEEDLE_RASTERS[index]);
 
-  ++page;
+  uint8_t start_page = SSD1306_PAGES_N;
+  uint8_t end_page = 0;
+  uint8_t start_column = SSD1306_COLUMNS_N - 1;
+  uint8_t end_column = 0;
 
-  /* Pages below the needle tip */
-  for (; page < SSD1306_PAGES_N; ++page) {
-    int8_t top_x = needle->column[page * SSD1306_PAGE_HEIGHT];
-    int8_t bottom_x = needle->column[(page + 1) * SSD1306_PAGE_HEIGHT - 1];
-    needle->start_column[page] = int_min(top_x, bottom_x);
-    needle->end_column[page] = int_max(top_x, bottom_x);
-  }
+  for (uint8_t page = 0; page < SSD1306_PAGES_N; ++page) {
+    const needle_page_raster_t *raster = &(needle->raster->pages[page]);
+    int8_t page_start_column = pgm_read_byte(&(raster->start_column));
 
-  /* Take account of needle shadow width */
-  for (page = 0; page < SSD1306_PAGES_N; ++page) {
-    if (needle->start_column[page] == -128) {
+    if (page_start_column == -128) {
       continue;
     }
 
-    if (needle->start_column[page] <= 3) {
-      needle->start_column[page] = 0;
-    }
-    else {
-      needle->start_column[page] -= 3;
-    }
-
-    if (needle->end_column[page] >= SSD1306_WIDTH - 3) {
-      needle->end_column[page] = SSD1306_WIDTH - 1;
-    }
-    else {
-      needle->end_column[page] += 3;
-    }
+    start_page = int_min(start_page, page);
+    end_page = page;
+    start_column = int_min(start_column, page_start_column);
+    end_column = int_max(end_column, (int8_t) pgm_read_byte(&(raster->end_column)));
   }
 
-#ifndef NDEBUG
-  for (page = 0; page < SSD1306_PAGES_N; ++page) {
-    assert(needle->start_column[page] <= needle->end_column[page]);
-  }
-#endif
+  sprite_set_bounds(&(needle->sprite), start_page, end_page, start_column, end_column);
 }
 
 
@@ -158,10 +76,13 @@ void
 needle_sprite_add_to_extents(needle_sprite_t *needle, update_extents_t *extents)
 {
   for (uint8_t page = 0; page < SSD1306_PAGES_N; ++page) {
-    if (needle->start_column[page] == -128) {
+    const needle_page_raster_t *raster = &(needle->raster->pages[page]);
+    int8_t start_column = pgm_read_byte(&(raster->start_column));
+
+    if (start_column == -128) {
       continue;
     }
 
-    update_extents_add_region(extents, page, needle->start_column[page], needle->end_column[page]);
+    update_extents_add_region(extents, page, start_column, pgm_read_byte(&(raster->end_column)));
   }
 }
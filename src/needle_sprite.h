@@ -2,20 +2,71 @@
 #define NEEDLE_SPRITE_H
 
 #include <stdint.h>
+#include <avr/pgmspace.h>
 #include "ssd1306.h"
+#include "utils.h"
 #include "display.h"
+#include "needle_coordinates.h"
 
 
 typedef struct needle_sprite_t_ {
   sprite_t sprite;
-  int8_t column[SSD1306_HEIGHT];
-  int8_t start_column[SSD1306_PAGES_N];
-  int8_t end_column[SSD1306_PAGES_N];
+  const needle_raster_t *raster; /* in program memory */
 } needle_sprite_t;
 
 
+inline void
+needle_sprite_render(sprite_t *sprite, uint8_t column_a, uint8_t page, uint8_t column_b, ssd1306_segment_t* segments)
+{
+  needle_sprite_t *needle = (needle_sprite_t *) sprite;
+  const needle_page_raster_t *raster = &(needle->raster->pages[page]);
+
+  int8_t start_column = pgm_read_byte(&(raster->start_column));
+  int8_t end_column = pgm_read_byte(&(raster->end_column));
+
+  if (start_column == -128) {
+    return;
+  }
+
+  int8_t x = pgm_read_byte(&(raster->column));
+  int8_t step = pgm_read_byte(&(needle->raster->step));
+  uint8_t steps = pgm_read_byte(&(raster->steps));
+  uint8_t tip_row = pgm_read_byte(&(needle->raster->tip_row));
+
+  /* Only columns inside of both needle extents and the chunk are touched */
+  int16_t column_lo = int_max(start_column, column_a);
+  int16_t column_hi = int_min(end_column, column_b);
+
+  /* Every row draws a single pixel with a shadow two pixels wide on both
+   * sides, so walk the rows and touch just the segments around the needle. */
+  for (uint8_t i = 0; i < SSD1306_PAGE_HEIGHT; ++i) {
+    uint8_t bit = 1 << i;
+
+    if (page * SSD1306_PAGE_HEIGHT + i >= tip_row) {
+      int16_t shadow_a = int_max(x - 2, column_lo);
+      int16_t shadow_b = int_min(x + 2, column_hi);
+
+      for (int16_t column = shadow_a; column <= shadow_b; ++column) {
+        segments[column - column_a] &= ~bit;
+      }
+
+      if (x >= column_lo && x <= column_hi) {
+        segments[x - column_a] |= bit;
+      }
+    }
+
+    if (steps & bit) {
+      x += step;
+    }
+  }
+}
+
+
 void needle_sprite_init(needle_sprite_t *needle);
 void needle_sprite_draw(needle_sprite_t *needle, uint8_t angle);
+void needle_sprite_draw_index(needle_sprite_t *needle, uint8_t index);
+uint8_t needle_sprite_get_index(needle_sprite_t *needle);
+uint8_t needle_angle_to_index(uint8_t angle);
 void needle_sprite_add_to_extents(needle_sprite_t *needle, update_extents_t *extents);
 
 
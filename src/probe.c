@@ -0,0 +1,102 @@
+#include "probe.h"
+#include <avr/pgmspace.h>
+#include <util/atomic.h>
+#include "lcd.h"
+
+
+#if PROBES_ENABLED
+
+#define PROBE_NAME(id, name) static const char PROBE_NAME_ ## id[] PROGMEM = name;
+PROBES(PROBE_NAME)
+#undef PROBE_NAME
+
+#define PROBE_NAME_POINTER(id, name) PROBE_NAME_ ## id,
+static const char * const PROBE_NAMES[PROBES_N] PROGMEM = {
+  PROBES(PROBE_NAME_POINTER)
+};
+#undef PROBE_NAME_POINTER
+
+
+static probe_t PROBES_DATA[PROBES_N];
+static uint8_t PROBE_TO_DUMP = 0;
+
+
+/* Called from both interrupt handlers and main loop */
+void
+probe_record(probe_id_t id, uint16_t cycles)
+{
+  probe_t *probe = &(PROBES_DATA[id]);
+
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    if (probe->count == 0 || cycles < probe->min) {
+      probe->min = cycles;
+    }
+
+    if (cycles > probe->max) {
+      probe->max = cycles;
+    }
+
+    probe->sum += cycles;
+    ++(probe->count);
+  }
+}
+
+
+void
+probe_reset(probe_id_t id)
+{
+  probe_t *probe = &(PROBES_DATA[id]);
+
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    probe->count = 0;
+    probe->min = 0;
+    probe->max = 0;
+    probe->sum = 0;
+  }
+}
+
+
+/* Copies probe and restarts its accumulation */
+void
+probe_take(probe_id_t id, probe_t *probe)
+{
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    *probe = PROBES_DATA[id];
+    probe_reset(id);
+  }
+}
+
+
+/* Shows a single probe on the LCD and restarts its accumulation, so every
+ * call is short and doesn't hold the frame loop for long. Next call shows the
+ * next probe.
+ *
+ *   name       count
+ *   min  mean  max
+ */
+void
+probe_dump_next(void)
+{
+  probe_t probe;
+
+  probe_take(PROBE_TO_DUMP, &probe);
+
+#if LCD_ENABLED
+  lcd_clear();
+  lcd_puts_P((const char *) pgm_read_ptr(&(PROBE_NAMES[PROBE_TO_DUMP])));
+  lcd_putc(' ');
+  lcd_put_long(probe.count);
+  lcd_goto(0, 1);
+  lcd_put_long(probe.min);
+  lcd_putc(' ');
+  lcd_put_long(probe.count ? probe.sum / probe.count : 0);
+  lcd_putc(' ');
+  lcd_put_long(probe.max);
+#endif
+
+  if (++PROBE_TO_DUMP == PROBES_N) {
+    PROBE_TO_DUMP = 0;
+  }
+}
+
+#endif
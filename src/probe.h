@@ -0,0 +1,64 @@
+#ifndef PROBE_H
+#define PROBE_H
+
+#include <stdint.h>
+#include <avr/io.h>
+#include "config.h"
+
+
+/* Probes measure time spent in a block of code, in CPU cycles counted by
+ * Timer/Counter1, which has to be started by benchmark_start(). Time spent
+ * in interrupt handlers, that happened to run inside of the block, is
+ * included. Blocks longer than 65535 cycles are not measured correctly.
+ */
+#define PROBES(X) \
+  X(NEEDLE_DRAW, "needle draw") \
+  X(RENDER_CHUNK, "render") \
+  X(EXTENTS, "extents") \
+  X(TWI_ISR, "TWI ISR")
+
+
+#define PROBE_ID(id, name) PROBE_ ## id,
+
+typedef enum probe_id_t_ {
+  PROBES(PROBE_ID)
+  PROBES_N
+} probe_id_t;
+
+#undef PROBE_ID
+
+
+typedef struct probe_t_ {
+  uint16_t count;
+  uint16_t min;
+  uint16_t max;
+  uint32_t sum;
+} probe_t;
+
+
+#if PROBES_ENABLED
+
+void probe_record(probe_id_t id, uint16_t cycles);
+void probe_reset(probe_id_t id);
+void probe_take(probe_id_t id, probe_t *probe);
+void probe_dump_next(void);
+
+#define PROBE_BEGIN(id) uint16_t probe_start_ ## id = TCNT1
+#define PROBE_END(id) probe_record(PROBE_ ## id, TCNT1 - probe_start_ ## id)
+
+#define PROBE(id, ...) \
+  do { \
+    PROBE_BEGIN(id); \
+    { __VA_ARGS__; } \
+    PROBE_END(id); \
+  } while (0)
+
+#else
+
+#define PROBE_BEGIN(id) do { } while (0)
+#define PROBE_END(id) do { } while (0)
+#define PROBE(id, ...) do { __VA_ARGS__; } while (0)
+
+#endif
+
+#endif /* PROBE_H */
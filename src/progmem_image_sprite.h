@@ -2,8 +2,10 @@
 #define PROGMEM_IMAGE_SPRITE_H
 
 #include <stdint.h>
+#include <avr/pgmspace.h>
 #include "ssd1306.h"
 #include "display.h"
+#include "utils.h"
 
 
 typedef struct progmem_image_sprite_t_ {
@@ -16,6 +18,28 @@ typedef struct progmem_image_sprite_t_ {
 } progmem_image_sprite_t;
 
 
+inline void
+progmem_image_sprite_render(sprite_t *sprite, uint8_t column_a, uint8_t page, uint8_t column_b, ssd1306_segment_t* segments)
+{
+  progmem_image_sprite_t *image = (progmem_image_sprite_t *) sprite;
+
+  /* Display renders the sprite only for chunks intersecting its bounds */
+  uint8_t target_column_a = int_max(column_a, image->sprite.start_column);
+  uint8_t target_column_b = int_min(column_b, image->sprite.end_column);
+  uint8_t source_column_a = target_column_a - image->column;
+  uint8_t source_page = page - image->page;
+
+  const uint8_t *source = image->data + source_column_a + source_page * image->width;
+  ssd1306_segment_t *target = segments + target_column_a - column_a;
+
+  for (uint8_t i = target_column_a; i <= target_column_b; ++i) {
+    *target = pgm_read_byte(source);
+    ++target;
+    ++source;
+  }
+}
+
+
 void progmem_image_sprite_init(progmem_image_sprite_t *image,
   const uint8_t *data, uint8_t column, uint8_t page);
 
@@ -0,0 +1,35 @@
+#include "progmem_rle_image_sprite.h"
+#include <stdlib.h>
+#include <string.h>
+#include <avr/pgmspace.h>
+#include "utils.h"
+#include "assert.h"
+
+
+extern inline void progmem_rle_image_sprite_render(sprite_t *sprite, uint8_t column_a, uint8_t page,
+  uint8_t column_b, ssd1306_segment_t* segments);
+
+
+void
+progmem_rle_image_sprite_init(progmem_rle_image_sprite_t *image, const uint8_t *data, uint8_t column, uint8_t page)
+{
+  sprite_init(&(image->sprite), &progmem_rle_image_sprite_render);
+  image->column = column;
+  image->page = page;
+
+  uint8_t width = pgm_read_byte(data);
+  uint8_t height = pgm_read_byte(data + 1) / SSD1306_PAGE_HEIGHT;
+
+  image->index = data + 2;
+  image->data = image->index + 2 * height;
+
+  /* Image segments replace whatever is below */
+  image->sprite.opaque = true;
+  sprite_set_bounds(
+    &(image->sprite),
+    page,
+    page + height - 1,
+    column,
+    column + width - 1
+  );
+}
@@ -0,0 +1,71 @@
+#ifndef PROGMEM_RLE_IMAGE_SPRITE_H
+#define PROGMEM_RLE_IMAGE_SPRITE_H
+
+#include <stdint.h>
+#include <string.h>
+#include <avr/pgmspace.h>
+#include "ssd1306.h"
+#include "display.h"
+#include "utils.h"
+
+
+/* Image compressed by image2c.py in rle format */
+typedef struct progmem_rle_image_sprite_t_ {
+  sprite_t sprite;
+  uint8_t column;
+  uint8_t page;
+  const uint8_t *index;
+  const uint8_t *data;
+} progmem_rle_image_sprite_t;
+
+
+/* Record header, see CRleBitmap in image2c.py */
+#define RLE_REPEAT (0x80)
+#define RLE_LENGTH_MASK (0x7f)
+
+
+inline void
+progmem_rle_image_sprite_render(sprite_t *sprite, uint8_t column_a, uint8_t page, uint8_t column_b, ssd1306_segment_t* segments)
+{
+  progmem_rle_image_sprite_t *image = (progmem_rle_image_sprite_t *) sprite;
+
+  /* Display renders the sprite only for chunks intersecting its bounds */
+  uint8_t target_column_a = int_max(column_a, image->sprite.start_column);
+  uint8_t target_column_b = int_min(column_b, image->sprite.end_column);
+
+  uint8_t source_page = page - image->page;
+  const uint8_t *source = image->data + pgm_read_word(image->index + 2 * source_page);
+  uint8_t column = image->column;
+
+  /* Records before the span are skipped, reading just their headers */
+  while (column <= target_column_b) {
+    uint8_t header = pgm_read_byte(source);
+    uint8_t length = (header & RLE_LENGTH_MASK) + 1;
+    ++source;
+
+    uint8_t record_end = column + length - 1;
+
+    if (record_end >= target_column_a) {
+      uint8_t from = int_max(column, target_column_a);
+      uint8_t to = int_min(record_end, target_column_b);
+      ssd1306_segment_t *target = segments + from - column_a;
+
+      if (header & RLE_REPEAT) {
+        memset(target, pgm_read_byte(source), to - from + 1);
+      }
+      else {
+        memcpy_P(target, source + from - column, to - from + 1);
+      }
+    }
+
+    source += (header & RLE_REPEAT) ? 1 : length;
+    column = record_end + 1;
+  }
+}
+
+
+void progmem_rle_image_sprite_init(progmem_rle_image_sprite_t *image,
+  const uint8_t *data, uint8_t column, uint8_t page);
+
+
+#endif /* PROGMEM_RLE_IMAGE_SPRITE_H */
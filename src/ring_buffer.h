@@ -3,41 +3,103 @@
 
 #include <stdbool.h>
 #include <stdint.h>
+#include "assert.h"
 
 
-typedef struct ring_buffer_t_ {
-  uint8_t element_size;
-  uint8_t elements_max;
-  uint8_t elements_n;
-  void *read_pointer;
-  void *write_pointer;
-  void *storage;
-} ring_buffer_t;
-
-
-void ring_buffer_init(ring_buffer_t *buffer, void *storage, uint8_t element_size, uint8_t elements_max);
-void ring_buffer_clear(ring_buffer_t *buffer);
-
-bool ring_buffer_is_empty(ring_buffer_t *buffer);
-uint8_t ring_buffer_get_size(ring_buffer_t *buffer);
-
-void ring_buffer_push_byte(ring_buffer_t *buffer, uint8_t byte);
-uint8_t ring_buffer_pop_byte(ring_buffer_t *buffer);
-
-void ring_buffer_push(ring_buffer_t *buffer, void *data);
-void ring_buffer_pop(ring_buffer_t *buffer, void *data);
-
-void * ring_buffer_get_first(ring_buffer_t *buffer);
-
-void * ring_buffer_append(ring_buffer_t *buffer);
-void ring_buffer_discard(ring_buffer_t *buffer);
-
-
-#define ring_buffer_assert_can_read_n_elements(buffer, n) \
-  assert((buffer)->elements_n >= (n))
-
-#define ring_buffer_assert_can_write_n_elements(buffer, n) \
-  assert((buffer)->elements_n + (n) <= (buffer)->elements_max)
+/* Defines name_t ring buffer of elements of given type, and its functions.
+ * Capacity is constant, a power of two up to 128, so free running 8 bit
+ * indices are just masked. Producer only writes head, after the element is
+ * stored, and consumer only writes tail, after it's done with the element.
+ * So a single producer and single consumer, like an interrupt handler and
+ * main loop, don't need to lock the buffer. A producer, that discards the
+ * oldest element to make room, writes tail too, so the other side has to
+ * access the buffer with the producer's interrupt disabled.
+ */
+#define RING_BUFFER_DEFINE(name, type, capacity) \
+  typedef char name ## _capacity_check_t[ \
+    (((capacity) & ((capacity) - 1)) == 0 && (capacity) <= 128) ? 1 : -1]; \
+  \
+  typedef struct name ## _t_ { \
+    type elements[capacity]; \
+    volatile uint8_t head; \
+    volatile uint8_t tail; \
+  } name ## _t; \
+  \
+  static inline void \
+  name ## _init(name ## _t *buffer) \
+  { \
+    buffer->head = 0; \
+    buffer->tail = 0; \
+  } \
+  \
+  static inline uint8_t \
+  name ## _get_size(name ## _t *buffer) \
+  { \
+    return (uint8_t) (buffer->head - buffer->tail); \
+  } \
+  \
+  static inline bool \
+  name ## _is_empty(name ## _t *buffer) \
+  { \
+    return buffer->head == buffer->tail; \
+  } \
+  \
+  static inline bool \
+  name ## _is_full(name ## _t *buffer) \
+  { \
+    return name ## _get_size(buffer) == (capacity); \
+  } \
+  \
+  /* Slot for the next element, has to be committed once it's filled in */ \
+  static inline type * \
+  name ## _reserve(name ## _t *buffer) \
+  { \
+    assert(!name ## _is_full(buffer)); \
+    return &(buffer->elements[buffer->head & ((capacity) - 1)]); \
+  } \
+  \
+  static inline void \
+  name ## _commit(name ## _t *buffer) \
+  { \
+    ++(buffer->head); \
+  } \
+  \
+  static inline void \
+  name ## _push(name ## _t *buffer, type element) \
+  { \
+    *(name ## _reserve(buffer)) = element; \
+    name ## _commit(buffer); \
+  } \
+  \
+  static inline type * \
+  name ## _get_first(name ## _t *buffer) \
+  { \
+    assert(!name ## _is_empty(buffer)); \
+    return &(buffer->elements[buffer->tail & ((capacity) - 1)]); \
+  } \
+  \
+  static inline void \
+  name ## _discard(name ## _t *buffer) \
+  { \
+    assert(!name ## _is_empty(buffer)); \
+    ++(buffer->tail); \
+  } \
+  \
+  static inline type \
+  name ## _pop(name ## _t *buffer) \
+  { \
+    type element = *(name ## _get_first(buffer)); \
+    name ## _discard(buffer); \
+    return element; \
+  } \
+  \
+  /* Element pushed `age` elements before the last one */ \
+  static inline type * \
+  name ## _get_newest(name ## _t *buffer, uint8_t age) \
+  { \
+    assert(age < name ## _get_size(buffer)); \
+    return &(buffer->elements[(uint8_t) (buffer->head - 1 - age) & ((capacity) - 1)]); \
+  }
 
 
 #endif /* RING_BUFFER_H */
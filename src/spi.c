@@ -0,0 +1,154 @@
+#include "spi.h"
+#include <avr/io.h>
+#include <util/delay.h>
+#include <util/atomic.h>
+#include "config.h"
+#include "assert.h"
+
+
+/* Byte takes 16 cycles at F_CPU/2, less than getting in and out of interrupt
+ * handler, so ports are written directly. Sending a byte waits only for the
+ * previous one, shifting out while the next one is prepared. */
+static bool SPI_BUSY;
+static bool SPI_USART_BUSY;
+
+
+void
+spi_init(void)
+{
+  PORTB |= _BV(SPI_CS_PIN);
+  DDRB |= _BV(SPI_RESET_PIN) | _BV(SPI_DC_PIN) | _BV(SPI_CS_PIN) | _BV(PB3) | _BV(PB5);
+  SPCR = _BV(SPE) | _BV(MSTR);
+  SPSR = _BV(SPI2X);
+
+  PORTD |= _BV(SPI_USART_CS_PIN);
+  DDRD |= _BV(SPI_USART_CS_PIN) | _BV(SPI_USART_DC_PIN) | _BV(PD4);
+  UBRR0 = 0;
+  UCSR0C = _BV(UMSEL01) | _BV(UMSEL00);
+  UCSR0B = _BV(TXEN0);
+  UBRR0 = 0; /* baud rate has to be set after transmitter is enabled */
+
+  PORTB &= ~_BV(SPI_RESET_PIN);
+  _delay_us(10);
+  PORTB |= _BV(SPI_RESET_PIN);
+}
+
+
+/* D/C is sampled with the last bit of a byte, so it can change only after
+ * the shifting is done, same as CS */
+static void
+spi_flush(uint8_t port)
+{
+  if (port == SPI_PORT_SPI) {
+    if (SPI_BUSY) {
+      while (!(SPSR & _BV(SPIF)));
+      SPI_BUSY = false;
+    }
+  }
+  else if (SPI_USART_BUSY) {
+    while (!(UCSR0A & _BV(TXC0)));
+    SPI_USART_BUSY = false;
+  }
+}
+
+
+void
+spi_select(uint8_t port, bool is_data)
+{
+  spi_flush(port);
+
+  if (port == SPI_PORT_SPI) {
+    if (is_data) {
+      PORTB |= _BV(SPI_DC_PIN);
+    }
+    else {
+      PORTB &= ~_BV(SPI_DC_PIN);
+    }
+
+    PORTB &= ~_BV(SPI_CS_PIN);
+  }
+  else {
+    if (is_data) {
+      PORTD |= _BV(SPI_USART_DC_PIN);
+    }
+    else {
+      PORTD &= ~_BV(SPI_USART_DC_PIN);
+    }
+
+    PORTD &= ~_BV(SPI_USART_CS_PIN);
+  }
+}
+
+
+void
+spi_deselect(uint8_t port)
+{
+  spi_flush(port);
+
+  if (port == SPI_PORT_SPI) {
+    PORTB |= _BV(SPI_CS_PIN);
+  }
+  else {
+    PORTD |= _BV(SPI_USART_CS_PIN);
+  }
+}
+
+
+static inline void
+spi_send_byte_spi(uint8_t octet)
+{
+  if (SPI_BUSY) {
+    while (!(SPSR & _BV(SPIF)));
+  }
+
+  SPDR = octet;
+  SPI_BUSY = true;
+}
+
+
+/* Transmit buffer holds one more byte, TXC is cleared with each one of them
+ * to tell when the last one is out. It's cleared right after the byte is
+ * written, so it can't be set by the previous byte in between, and an
+ * interrupt handler can't delay it past the end of the new one. */
+static inline void
+spi_send_byte_usart(uint8_t octet)
+{
+  while (!(UCSR0A & _BV(UDRE0)));
+
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    UDR0 = octet;
+    UCSR0A = _BV(TXC0);
+  }
+
+  SPI_USART_BUSY = true;
+}
+
+
+void
+spi_send_byte(uint8_t port, uint8_t octet)
+{
+  if (port == SPI_PORT_SPI) {
+    spi_send_byte_spi(octet);
+  }
+  else {
+    spi_send_byte_usart(octet);
+  }
+}
+
+
+void
+spi_send_bytes(uint8_t port, const uint8_t *data, uint8_t n)
+{
+  assert(n > 0);
+
+  if (port == SPI_PORT_SPI) {
+    for (uint8_t i = 0; i < n; ++i) {
+      spi_send_byte_spi(data[i]);
+    }
+  }
+  else {
+    for (uint8_t i = 0; i < n; ++i) {
+      spi_send_byte_usart(data[i]);
+    }
+  }
+}
@@ -0,0 +1,30 @@
+#ifndef SPI_H
+#define SPI_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "config.h"
+
+
+/* Each display has its own port, both clocked at F_CPU/2: hardware SPI with
+ * CS on SS, and USART in master SPI mode, with clock on XCK. Reset is shared.
+ */
+#define SPI_PORT_SPI (0)
+#define SPI_PORT_USART (1)
+
+#define SPI_RESET_PIN (PB0)
+#define SPI_DC_PIN (PB1)
+#define SPI_CS_PIN (PB2)
+#define SPI_USART_CS_PIN (PD5)
+#define SPI_USART_DC_PIN (PD6)
+
+
+void spi_init(void);
+
+void spi_select(uint8_t port, bool is_data);
+void spi_deselect(uint8_t port);
+void spi_send_byte(uint8_t port, uint8_t octet);
+void spi_send_bytes(uint8_t port, const uint8_t *data, uint8_t n);
+
+
+#endif /* SPI_H */
@@ -1,10 +1,35 @@
 #include "ssd1306.h"
 #include <avr/pgmspace.h>
+#if DISPLAY_TRANSPORT == DISPLAY_TRANSPORT_SPI
+#include "spi.h"
+#else
 #include "i2c.h"
+#endif
 
 #define SSD1306_MAX_COLUMN_ADDRESS (SSD1306_COLUMNS_N - 1)
 #define SSD1306_MAX_PAGE_ADDRESS (SSD1306_PAGES_N - 1)
 
+#if TRAFFIC_STATS
+#define SSD1306_COUNT(device, counter, n) ((device)->stats.counter += (n))
+#else
+#define SSD1306_COUNT(device, counter, n) do { } while (0)
+#endif
+
+#if DISPLAY_TRANSPORT == DISPLAY_TRANSPORT_SPI
+/* Nothing to write into in place, bytes are sent right away anyway */
+static ssd1306_segment_t SSD1306_RESERVED[I2C_RESERVE_MAX];
+
+#define ssd1306_send_byte(device, octet) spi_send_byte((device)->address, (octet))
+#define ssd1306_send_bytes(device, data, n) spi_send_bytes((device)->address, (data), (n))
+#define ssd1306_reserve_bytes(device, n) (SSD1306_RESERVED)
+#define ssd1306_commit_bytes(device, n) spi_send_bytes((device)->address, SSD1306_RESERVED, (n))
+#else
+#define ssd1306_send_byte(device, octet) i2c_async_send_byte(octet)
+#define ssd1306_send_bytes(device, data, n) i2c_async_send_bytes((data), (n))
+#define ssd1306_reserve_bytes(device, n) i2c_async_reserve_bytes(n)
+#define ssd1306_commit_bytes(device, n) i2c_async_commit_bytes(n)
+#endif
+
 
 static const uint8_t SSD1306_INIT_SEQUENCE[] PROGMEM = {
     0x00,
@@ -32,28 +57,42 @@ static const uint8_t SSD1306_INIT_SEQUENCE[] PROGMEM = {
 
 
 void
-ssd1306_init(ssd1306_t *device, uint8_t address)
+ssd1306_init(ssd1306_t *device, uint8_t address, uint8_t channel)
 {
   device->address = address;
+  device->channel = channel;
   device->cursor_column = 0;
   device->cursor_page = 0;
+  device->window_start_column = 0;
+  device->window_end_column = SSD1306_MAX_COLUMN_ADDRESS;
+  device->window_start_page = 0;
+  device->window_end_page = SSD1306_MAX_PAGE_ADDRESS;
   device->i2c_mode = SSD1306_I2C_MODE_NOT_SELECTED;
-  i2c_transmit_progmem(device->address, SSD1306_INIT_SEQUENCE, sizeof(SSD1306_INIT_SEQUENCE));
+  device->init_pending = true;
+#if TRAFFIC_STATS
+  ssd1306_reset_stats(device);
+#endif
 }
 
 
+#if DISPLAY_TRANSPORT == DISPLAY_TRANSPORT_SPI
+/* Each device has its own port, fast enough for producer to write directly to
+ * it, so callback is just called until it's done. Modes are selected by CS and
+ * D/C lines. */
 void
 ssd1306_start_update(ssd1306_t *device, ssd1306_update_callback_t callback, void *data)
 {
-  i2c_transmit_async(device->address, callback, data);
+  while (callback(data));
 }
 
 
 void
 ssd1306_finish_update(ssd1306_t *device)
 {
-  device->i2c_mode = SSD1306_I2C_MODE_NOT_SELECTED;
-  i2c_async_end_transmission();
+  if (device->i2c_mode != SSD1306_I2C_MODE_NOT_SELECTED) {
+    device->i2c_mode = SSD1306_I2C_MODE_NOT_SELECTED;
+    spi_deselect(device->address);
+  }
 }
 
 
@@ -61,29 +100,270 @@ static void
 ssd1306_switch_i2c_mode(ssd1306_t *device, ssd1306_i2c_mode_t i2c_mode)
 {
   if (device->i2c_mode != i2c_mode) {
-    i2c_async_send_start();
+    spi_select(device->address, i2c_mode == SSD1306_I2C_MODE_DATA);
+    device->i2c_mode = i2c_mode;
+
+    SSD1306_COUNT(device, starts, 1);
+  }
+}
+
+
+/* Producer writes straight to the port, nothing to fill up, and a put has no
+ * overhead to reserve either */
+uint8_t
+ssd1306_capacity(uint8_t puts_n)
+{
+  (void) puts_n;
+  return 0xff;
+}
+
+
+/* Control byte of I2C is skipped, D/C line tells commands apart instead */
+bool
+ssd1306_send_init_sequence(ssd1306_t *device)
+{
+  if (!device->init_pending) {
+    return false;
+  }
+
+  ssd1306_switch_i2c_mode(device, SSD1306_I2C_MODE_COMMAND);
+
+  for (uint8_t i = 1; i < sizeof(SSD1306_INIT_SEQUENCE); ++i) {
+    ssd1306_send_byte(device, pgm_read_byte(SSD1306_INIT_SEQUENCE + i));
+  }
+
+  device->init_pending = false;
+  return true;
+}
+#else
+void
+ssd1306_start_update(ssd1306_t *device, ssd1306_update_callback_t callback, void *data)
+{
+  i2c_transmit_async(device->channel, device->address, callback, data);
+}
+
+
+/* Back buffer bytes, that a single ssd1306_put_segments() can take besides the
+ * segments at most: switching to commands, window and cursor commands,
+ * switching back to data, data run split in two, and STOP at the end. Window
+ * of multipage region, set before its first segments, takes less. */
+#define SSD1306_PUT_OVERHEAD (4 + 9 + 4 + 1 + 1)
+
+
+/* Segments that surely fit into what's left of the I2C buffer, in total for
+ * `puts_n` calls putting them, so producer can fill it up */
+uint8_t
+ssd1306_capacity(uint8_t puts_n)
+{
+  uint8_t capacity = i2c_async_capacity();
+  uint8_t overhead = puts_n * SSD1306_PUT_OVERHEAD;
+
+  return (capacity > overhead) ? capacity - overhead : 0;
+}
+
+
+/* Devices can take turns within single transaction, for the same update.
+ * Device addressed last holds the bus, others have to send START again. */
+static ssd1306_t *SSD1306_ADDRESSED;
+
+
+void
+ssd1306_finish_update(ssd1306_t *device)
+{
+  if (device->i2c_mode != SSD1306_I2C_MODE_NOT_SELECTED) {
+    device->i2c_mode = SSD1306_I2C_MODE_NOT_SELECTED;
+
+    if (SSD1306_ADDRESSED == device) {
+      SSD1306_ADDRESSED = NULL;
+      i2c_async_end_transmission();
+    }
+  }
+}
+
+
+static void
+ssd1306_switch_i2c_mode(ssd1306_t *device, ssd1306_i2c_mode_t i2c_mode)
+{
+  if (device->i2c_mode != i2c_mode || SSD1306_ADDRESSED != device) {
+    i2c_async_send_start_to(device->address);
     i2c_async_send_byte(i2c_mode);
     device->i2c_mode = i2c_mode;
+    SSD1306_ADDRESSED = device;
+
+    SSD1306_COUNT(device, starts, 1);
+    SSD1306_COUNT(device, address_bytes, 1);
+    SSD1306_COUNT(device, control_bytes, 1);
+  }
+}
+
+
+/* Sequence starts with the control byte, and leaves the device in command
+ * mode. It's sent in a callback call of its own, to fit into the buffer. */
+bool
+ssd1306_send_init_sequence(ssd1306_t *device)
+{
+  if (!device->init_pending) {
+    return false;
   }
+
+  i2c_async_send_start_to(device->address);
+
+  for (uint8_t i = 0; i < sizeof(SSD1306_INIT_SEQUENCE); ++i) {
+    ssd1306_send_byte(device, pgm_read_byte(SSD1306_INIT_SEQUENCE + i));
+  }
+
+  device->i2c_mode = SSD1306_I2C_MODE_COMMAND;
+  device->init_pending = false;
+  SSD1306_ADDRESSED = device;
+
+  SSD1306_COUNT(device, starts, 1);
+  SSD1306_COUNT(device, address_bytes, 1);
+  SSD1306_COUNT(device, control_bytes, 1);
+  return true;
 }
+#endif
 
 
+/* Setting column or page window also moves the pointer to its start, each
+ * of them is sent only if needed. */
+static void
+ssd1306_set_column_window(ssd1306_t *device, uint8_t start_column, uint8_t end_column)
+{
+  ssd1306_switch_i2c_mode(device, SSD1306_I2C_MODE_COMMAND);
+
+  ssd1306_send_byte(device, SSD1306_CMD_SET_COLUMN_ADDRESS);
+  ssd1306_send_byte(device, start_column);
+  ssd1306_send_byte(device, end_column);
+
+  device->cursor_column = start_column;
+  device->window_start_column = start_column;
+  device->window_end_column = end_column;
+
+  SSD1306_COUNT(device, cursor_bytes, 3);
+}
+
+
+static void
+ssd1306_set_page_window(ssd1306_t *device, uint8_t start_page, uint8_t end_page)
+{
+  ssd1306_switch_i2c_mode(device, SSD1306_I2C_MODE_COMMAND);
+
+  ssd1306_send_byte(device, SSD1306_CMD_SET_PAGE_ADDRESS);
+  ssd1306_send_byte(device, start_page);
+  ssd1306_send_byte(device, end_page);
+
+  device->cursor_page = start_page;
+  device->window_start_page = start_page;
+  device->window_end_page = end_page;
+
+  SSD1306_COUNT(device, cursor_bytes, 3);
+}
+
+
+/* Moves cursor to the top left corner of the window */
+void
+ssd1306_set_window(ssd1306_t *device, uint8_t start_column, uint8_t end_column,
+                   uint8_t start_page, uint8_t end_page)
+{
+  bool moved = false;
+
+  if (device->cursor_column != start_column || device->window_start_column != start_column ||
+    device->window_end_column != end_column)
+  {
+    ssd1306_set_column_window(device, start_column, end_column);
+    moved = true;
+  }
+
+  if (device->cursor_page != start_page || device->window_start_page != start_page ||
+    device->window_end_page != end_page)
+  {
+    ssd1306_set_page_window(device, start_page, end_page);
+    moved = true;
+  }
+
+  if (moved) {
+    SSD1306_COUNT(device, cursor_moves, 1);
+  }
+}
+
+
+/* Bytes to send to move the cursor before sending data, compared to just
+ * sending data from where the cursor is. Switching between commands and data
+ * needs a (repeated) START, address and control byte, counted as 3 bytes. In
+ * data mode two of them are needed, to commands and back again. On SPI it's
+ * just D/C line, but the last byte has to be shifted out before.
+ */
+#if DISPLAY_TRANSPORT == DISPLAY_TRANSPORT_SPI
+#define SSD1306_MODE_SWITCH_COST (1)
+#else
+#define SSD1306_MODE_SWITCH_COST (3)
+#endif
+#define SSD1306_ADDRESS_COMMAND_COST (3)
+
+uint8_t
+ssd1306_reposition_cost(ssd1306_i2c_mode_t i2c_mode, bool page_changes)
+{
+  uint8_t cost = SSD1306_ADDRESS_COMMAND_COST;
+
+  if (page_changes) {
+    cost += SSD1306_ADDRESS_COMMAND_COST;
+  }
+
+  if (i2c_mode == SSD1306_I2C_MODE_DATA) {
+    cost += 2 * SSD1306_MODE_SWITCH_COST;
+  }
+  else if (i2c_mode == SSD1306_I2C_MODE_NOT_SELECTED) {
+    cost += SSD1306_MODE_SWITCH_COST;
+  }
+
+  return cost;
+}
+
+
+/* Window is left as it is if the cursor already is in position, otherwise
+ * it spans from cursor to the end of display, in the direction that changed.
+ */
 void
 ssd1306_move_to(ssd1306_t *device, uint8_t column, uint8_t page)
 {
-  if (device->cursor_column != column || device->cursor_page != page) {
-    ssd1306_switch_i2c_mode(device, SSD1306_I2C_MODE_COMMAND);
+  if (device->cursor_column == column && device->cursor_page == page) {
+    return;
+  }
 
-    i2c_async_send_byte(SSD1306_CMD_SET_COLUMN_ADDRESS);
-    i2c_async_send_byte(column);
-    i2c_async_send_byte(SSD1306_MAX_COLUMN_ADDRESS);
-    i2c_async_send_byte(SSD1306_CMD_SET_PAGE_ADDRESS);
-    i2c_async_send_byte(page);
-    i2c_async_send_byte(SSD1306_MAX_PAGE_ADDRESS);
+  if (device->cursor_column != column) {
+    ssd1306_set_column_window(device, column, SSD1306_MAX_COLUMN_ADDRESS);
+  }
 
-    device->cursor_column = column;
-    device->cursor_page = page;
+  if (device->cursor_page != page) {
+    ssd1306_set_page_window(device, page, SSD1306_MAX_PAGE_ADDRESS);
   }
+
+  SSD1306_COUNT(device, cursor_moves, 1);
+}
+
+
+/* Pointer wraps at the window edge, to the next page of the window, and from
+ * its end back to the start. Addressing is always horizontal, set by the init
+ * sequence. */
+static void
+ssd1306_advance_cursor(ssd1306_t *device, uint8_t length)
+{
+  uint8_t start_column = device->window_start_column;
+  uint8_t end_column = device->window_end_column;
+  uint8_t start_page = device->window_start_page;
+  uint8_t end_page = device->window_end_page;
+
+  if (device->cursor_column + length <= end_column) {
+    device->cursor_column += length;
+    return;
+  }
+
+  uint8_t columns_n = end_column - start_column + 1;
+  uint8_t pages_n = end_page - start_page + 1;
+  uint16_t offset = (device->cursor_column - start_column) + length;
+
+  device->cursor_column = start_column + offset % columns_n;
+  device->cursor_page = start_page + (device->cursor_page - start_page + offset / columns_n) % pages_n;
 }
 
 
@@ -91,15 +371,62 @@ void
 ssd1306_write_gddram(ssd1306_t *device, uint8_t length, uint8_t *data)
 {
   ssd1306_switch_i2c_mode(device, SSD1306_I2C_MODE_DATA);
-  i2c_async_send_bytes(data, length);
+  ssd1306_send_bytes(device, data, length);
 
-  device->cursor_column += length;
+  ssd1306_advance_cursor(device, length);
+  SSD1306_COUNT(device, payload_bytes, length);
 }
 
 
+static void
+ssd1306_prepare_segments(ssd1306_t *device, uint8_t column, uint8_t page, uint8_t width)
+{
+  if (column + width - 1 > device->window_end_column) {
+    /* Segments wouldn't fit into the window */
+    ssd1306_set_column_window(device, column, SSD1306_MAX_COLUMN_ADDRESS);
+  }
+
+  ssd1306_move_to(device, column, page);
+}
+
+
+/* Segments are put on a single page, in horizontal addressing mode */
 void
 ssd1306_put_segments(ssd1306_t *device, uint8_t column, uint8_t page, uint8_t width, uint8_t *segments)
 {
-  ssd1306_move_to(device, column, page);
+  ssd1306_prepare_segments(device, column, page, width);
   ssd1306_write_gddram(device, width, segments);
 }
+
+
+/* Same as ssd1306_put_segments(), but segments are written by the caller
+ * directly into the returned space, and sent by ssd1306_commit_segments().
+ * Nothing else can be sent to any device in between.
+ */
+ssd1306_segment_t *
+ssd1306_reserve_segments(ssd1306_t *device, uint8_t column, uint8_t page, uint8_t width)
+{
+  ssd1306_prepare_segments(device, column, page, width);
+  ssd1306_switch_i2c_mode(device, SSD1306_I2C_MODE_DATA);
+
+  return ssd1306_reserve_bytes(device, width);
+}
+
+
+void
+ssd1306_commit_segments(ssd1306_t *device, uint8_t width)
+{
+  ssd1306_commit_bytes(device, width);
+
+  ssd1306_advance_cursor(device, width);
+  SSD1306_COUNT(device, payload_bytes, width);
+}
+
+
+#if TRAFFIC_STATS
+void
+ssd1306_reset_stats(ssd1306_t *device)
+{
+  device->stats = (ssd1306_stats_t) {0};
+}
+#endif
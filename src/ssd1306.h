@@ -3,6 +3,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include "config.h"
 
 #define SSD1306_COLUMNS_N (128)
 #define SSD1306_PAGES_N (8)
@@ -37,31 +38,68 @@
 
 typedef uint8_t ssd1306_segment_t;
 
+/* On SPI it's the D/C line, and CS when not selected */
 typedef enum ssd1306_i2c_mode_t_ {
   SSD1306_I2C_MODE_COMMAND = 0x00,
   SSD1306_I2C_MODE_DATA = 0x40,
   SSD1306_I2C_MODE_NOT_SELECTED = 0xff
 } ssd1306_i2c_mode_t;
 
+/* Bytes sent to the device since the last reset, by kind */
+typedef struct ssd1306_stats_t_ {
+  uint16_t starts;
+  uint16_t address_bytes;
+  uint16_t control_bytes;
+  uint16_t cursor_moves;
+  uint16_t cursor_bytes;
+  uint16_t payload_bytes;
+} ssd1306_stats_t;
+
+/* GDDRAM pointer advances inside of the window, wrapping to its other side,
+ * so a rectangle can be sent as a single stream of segments. Cursor and
+ * window are tracked to send only commands, that actually change them.
+ */
 typedef struct ssd1306_t_ {
-  uint8_t address;
+  uint8_t address; /* or port, with SPI transport */
+  uint8_t channel; /* of I2C_MUX the device is behind */
   uint8_t cursor_column;
   uint8_t cursor_page;
+  uint8_t window_start_column;
+  uint8_t window_end_column;
+  uint8_t window_start_page;
+  uint8_t window_end_page;
   ssd1306_i2c_mode_t i2c_mode;
+  bool init_pending; /* init sequence goes first with the first update */
+#if TRAFFIC_STATS
+  ssd1306_stats_t stats;
+#endif
 } ssd1306_t;
 
 typedef bool (*ssd1306_update_callback_t)(void *data);
 
 
-void ssd1306_init(ssd1306_t *device, uint8_t address);
+void ssd1306_init(ssd1306_t *device, uint8_t address, uint8_t channel);
 
 void ssd1306_start_update(ssd1306_t *device, ssd1306_update_callback_t callback, void *data);
+bool ssd1306_send_init_sequence(ssd1306_t *device);
 
+uint8_t ssd1306_reposition_cost(ssd1306_i2c_mode_t i2c_mode, bool page_changes);
+
+void ssd1306_set_window(ssd1306_t *device, uint8_t start_column, uint8_t end_column,
+                        uint8_t start_page, uint8_t end_page);
 void ssd1306_move_to(ssd1306_t *device, uint8_t column, uint8_t page);
 void ssd1306_put_segments(ssd1306_t *device, uint8_t column, uint8_t page,
                           uint8_t width, uint8_t *segments);
+ssd1306_segment_t *ssd1306_reserve_segments(ssd1306_t *device, uint8_t column, uint8_t page,
+                                            uint8_t width);
+void ssd1306_commit_segments(ssd1306_t *device, uint8_t width);
+uint8_t ssd1306_capacity(uint8_t puts_n);
 
 void ssd1306_finish_update(ssd1306_t *device);
 
+#if TRAFFIC_STATS
+void ssd1306_reset_stats(ssd1306_t *device);
+#endif
+
 
 #endif /* SSD1306_H */
@@ -0,0 +1,92 @@
+#include "telemetry.h"
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include "config.h"
+#include "ring_buffer.h"
+
+
+#if TELEMETRY
+
+#if DISPLAY_TRANSPORT == DISPLAY_TRANSPORT_SPI
+#error "USART is taken by the display on SPI"
+#endif
+
+/* Double speed mode, so 250 kbaud and 500 kbaud are exact at 20MHz */
+#define TELEMETRY_UBRR (F_CPU / (8L * TELEMETRY_BAUD) - 1)
+
+#define TELEMETRY_RECORD_OVERHEAD (3)
+
+typedef char telemetry_buffer_size_check_t[
+  (sizeof(telemetry_frame_t) + TELEMETRY_RECORD_OVERHEAD <= TELEMETRY_BUFFER_SIZE) ? 1 : -1];
+
+
+/* Filled by the frame loop, drained by data register empty interrupt */
+RING_BUFFER_DEFINE(telemetry_bytes, uint8_t, TELEMETRY_BUFFER_SIZE)
+
+static telemetry_bytes_t TELEMETRY_BYTES;
+static uint8_t TELEMETRY_SEQUENCE;
+
+
+void
+telemetry_init(void)
+{
+  telemetry_bytes_init(&TELEMETRY_BYTES);
+  TELEMETRY_SEQUENCE = 0;
+
+  UBRR0 = TELEMETRY_UBRR;
+  UCSR0A = _BV(U2X0);
+  UCSR0C = _BV(UCSZ01) | _BV(UCSZ00);
+  UCSR0B = _BV(TXEN0);
+}
+
+
+static inline void
+telemetry_push(uint8_t octet)
+{
+  telemetry_bytes_push(&TELEMETRY_BYTES, octet);
+}
+
+
+/* Never waits for the UART, so it doesn't disturb frame timing. Record is
+ * dropped, if there's no space for it. */
+bool
+telemetry_send_frame(telemetry_frame_t *frame)
+{
+  uint8_t length = sizeof(telemetry_frame_t);
+
+  frame->sequence = TELEMETRY_SEQUENCE++;
+
+  if (TELEMETRY_BUFFER_SIZE - telemetry_bytes_get_size(&TELEMETRY_BYTES) < length + TELEMETRY_RECORD_OVERHEAD) {
+    return false;
+  }
+
+  const uint8_t *payload = (const uint8_t *) frame;
+  uint8_t checksum = 0;
+
+  telemetry_push(TELEMETRY_SYNC);
+  telemetry_push(length);
+
+  for (uint8_t i = 0; i < length; ++i) {
+    telemetry_push(payload[i]);
+    checksum += payload[i];
+  }
+
+  telemetry_push(checksum);
+
+  UCSR0B |= _BV(UDRIE0);
+
+  return true;
+}
+
+
+ISR(USART_UDRE_vect)
+{
+  if (telemetry_bytes_is_empty(&TELEMETRY_BYTES)) {
+    UCSR0B &= ~_BV(UDRIE0);
+    return;
+  }
+
+  UDR0 = telemetry_bytes_pop(&TELEMETRY_BYTES);
+}
+
+#endif
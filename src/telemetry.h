@@ -0,0 +1,49 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "config.h"
+#include "adc.h"
+#include "probe.h"
+
+
+/* Record is sent for every frame, framed as:
+ *
+ *   TELEMETRY_SYNC, payload length, payload, 8 bit sum of payload bytes
+ *
+ * Payload is telemetry_frame_t as it is in memory, packed and little endian.
+ * Probes are included only if they're enabled, their number follows from the
+ * length. Records that don't fit into the transmit buffer are dropped, which
+ * shows as a gap in sequence numbers. See telemetry.py for decoding.
+ */
+#define TELEMETRY_SYNC (0xA5)
+
+#define TELEMETRY_FLAG_TRAFFIC_STATS (0x01)
+#define TELEMETRY_FLAG_PEAK (0x02)
+
+
+typedef struct telemetry_probe_t_ {
+  uint16_t count;
+  uint32_t sum;
+  uint16_t max;
+} telemetry_probe_t;
+
+typedef struct telemetry_frame_t_ {
+  uint8_t sequence;
+  uint8_t flags;
+  uint16_t frame_time; /* us, saturated */
+  uint16_t adc[ADC_CHANNELS_N];
+  uint8_t needle[ADC_CHANNELS_N];
+  uint16_t bus_bytes; /* since the last frame, with TRAFFIC_STATS only */
+#if PROBES_ENABLED
+  telemetry_probe_t probes[PROBES_N];
+#endif
+} telemetry_frame_t;
+
+
+void telemetry_init(void);
+bool telemetry_send_frame(telemetry_frame_t *frame);
+
+
+#endif /* TELEMETRY_H */
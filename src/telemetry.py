@@ -0,0 +1,207 @@
+import sys
+import os
+import re
+import argparse
+from struct import unpack_from
+
+
+# Record framing and payload layout, see telemetry.h
+SYNC = 0xA5
+FRAME_FORMAT = "<BBHHHBBH"
+FRAME_SIZE = 12
+PROBE_FORMAT = "<HIH"
+PROBE_SIZE = 8
+FLAG_TRAFFIC_STATS = 0x01
+FLAG_PEAK = 0x02
+
+F_CPU = 20000000
+
+
+def probe_names():
+  """Names in order of PROBES() in probe.h"""
+  path = os.path.join(os.path.dirname(os.path.abspath(__file__)), "probe.h")
+
+  with open(path) as probe_h:
+    return re.findall(r"X\(\w+, \"([^\"]+)\"\)", probe_h.read())
+
+
+def open_input(path, baud):
+  if path == "-":
+    return sys.stdin.buffer
+
+  if os.path.isfile(path):
+    return open(path, "rb")
+
+  import serial
+  return serial.Serial(path, baud)
+
+
+def read_records(stream, capture=None):
+  """Yields payloads of valid records, resynchronizing on broken ones"""
+  data = bytearray()
+  is_serial = hasattr(stream, "in_waiting")
+
+  while True:
+    # serial port blocks until whole chunk is read, so take what is there
+    chunk = stream.read(max(1, stream.in_waiting) if is_serial else 256)
+
+    if not chunk:
+      return
+
+    if capture:
+      capture.write(chunk)
+
+    data += chunk
+
+    while True:
+      start = data.find(SYNC)
+
+      if start < 0:
+        data.clear()
+        break
+
+      del data[:start]
+
+      if len(data) < 2:
+        break
+
+      length = data[1]
+
+      if length < FRAME_SIZE or (length - FRAME_SIZE) % PROBE_SIZE != 0:
+        del data[:1]
+        continue
+
+      if len(data) < length + 3:
+        break
+
+      payload = bytes(data[2:2 + length])
+
+      if sum(payload) & 0xff == data[2 + length]:
+        del data[:length + 3]
+        yield payload
+      else:
+        del data[:1]
+
+
+def decode(payload):
+  fields = unpack_from(FRAME_FORMAT, payload)
+  frame = {
+    "sequence": fields[0],
+    "flags": fields[1],
+    "frame_time": fields[2],
+    "adc": fields[3:5],
+    "needle": fields[5:7],
+    "bus_bytes": fields[7] if fields[1] & FLAG_TRAFFIC_STATS else None,
+    "peak": bool(fields[1] & FLAG_PEAK),
+    "probes": [],
+  }
+
+  for offset in range(FRAME_SIZE, len(payload), PROBE_SIZE):
+    frame["probes"].append(unpack_from(PROBE_FORMAT, payload, offset))
+
+  return frame
+
+
+def text_histogram(title, values, bins=16, width=50):
+  print(title)
+
+  if not values:
+    print("  no data\n")
+    return
+
+  low, high = min(values), max(values)
+  step = max((high - low) / bins, 1e-9)
+  counts = [0] * bins
+
+  for value in values:
+    counts[min(int((value - low) / step), bins - 1)] += 1
+
+  for i, count in enumerate(counts):
+    bar = "#" * (count * width // max(counts))
+    print("  %10.1f %6d %s" % (low + i * step, count, bar))
+
+  print()
+
+
+def summarize(frames, names):
+  frame_times = [frame["frame_time"] for frame in frames if frame["frame_time"] > 0]
+  fps = [1000000.0 / frame_time for frame_time in frame_times]
+  dropped = sum((b["sequence"] - a["sequence"] - 1) & 0xff for a, b in zip(frames, frames[1:]))
+
+  print("frames:     %d (%d dropped)" % (len(frames), dropped))
+
+  if frame_times:
+    print("frame time: %.0f us mean, %d us max" % (sum(frame_times) / len(frame_times), max(frame_times)))
+    print("fps:        %.1f mean" % (len(frame_times) * 1000000.0 / sum(frame_times)))
+
+  bus_bytes = [frame["bus_bytes"] for frame in frames if frame["bus_bytes"] is not None]
+
+  if bus_bytes:
+    print("bus bytes:  %.1f per frame" % (sum(bus_bytes) / len(bus_bytes)))
+
+  print("peaks:      %d frames" % sum(frame["peak"] for frame in frames))
+
+  probes_n = max((len(frame["probes"]) for frame in frames), default=0)
+
+  for i in range(probes_n):
+    count = sum(frame["probes"][i][0] for frame in frames if len(frame["probes"]) > i)
+    total = sum(frame["probes"][i][1] for frame in frames if len(frame["probes"]) > i)
+    maximum = max(frame["probes"][i][2] for frame in frames if len(frame["probes"]) > i)
+    name = names[i] if i < len(names) else "probe %d" % i
+    mean = total / count if count else 0
+
+    print("  %-12s %7d calls, %8.1f us mean, %8.1f us max" % (
+      name, count, mean * 1e6 / F_CPU, maximum * 1e6 / F_CPU))
+
+  print()
+
+  return fps, frame_times
+
+
+def plot(fps, frame_times, output):
+  import matplotlib
+  if output:
+    matplotlib.use("Agg")
+  import matplotlib.pyplot as plt
+
+  figure, (fps_axes, time_axes) = plt.subplots(1, 2, figsize=(10, 4))
+  fps_axes.hist(fps, bins=50)
+  fps_axes.set_xlabel("FPS")
+  fps_axes.set_ylabel("frames")
+  time_axes.hist(frame_times, bins=50)
+  time_axes.set_xlabel("frame time [us]")
+  figure.tight_layout()
+
+  if output:
+    figure.savefig(output)
+  else:
+    plt.show()
+
+
+parser = argparse.ArgumentParser(description="Decodes telemetry records sent by the firmware over UART")
+parser.add_argument("input", help="serial port, captured file, or - for standard input")
+parser.add_argument("--baud", type=int, default=250000, help="TELEMETRY_BAUD from config.h")
+parser.add_argument("--frames", type=int, default=0, help="stop after given number of frames")
+parser.add_argument("--capture", help="save raw stream to a file, to compare builds later")
+parser.add_argument("--plot", nargs="?", const="", help="plot histograms, into a file if given")
+args = parser.parse_args()
+
+capture = open(args.capture, "wb") if args.capture else None
+frames = []
+
+try:
+  for payload in read_records(open_input(args.input, args.baud), capture):
+    frames.append(decode(payload))
+
+    if args.frames and len(frames) >= args.frames:
+      break
+except KeyboardInterrupt:
+  pass
+
+fps, frame_times = summarize(frames, probe_names())
+
+if args.plot is not None:
+  plot(fps, frame_times, args.plot)
+else:
+  text_histogram("FPS", fps)
+  text_histogram("frame time [us]", frame_times)
@@ -0,0 +1,121 @@
+#include "text_sprite.h"
+#include <stdlib.h>
+#include <avr/pgmspace.h>
+#include "utils.h"
+#include "assert.h"
+
+
+/* Renderer is inlined into display_render_layers(), but sprites point to this
+ * external definition */
+extern inline void text_sprite_render(sprite_t *sprite, uint8_t column_a, uint8_t page,
+  uint8_t column_b, ssd1306_segment_t* segments);
+
+
+/* Characters other than digits, with glyphs following those of digits */
+static const char TEXT_SPRITE_SYMBOLS[] PROGMEM = " +-.dB";
+
+/* Segments of each glyph, least significant bit at the top */
+const uint8_t TEXT_SPRITE_FONT[][TEXT_SPRITE_GLYPH_WIDTH] PROGMEM = {
+  { 0x3e, 0x51, 0x49, 0x45, 0x3e }, /* 0 */
+  { 0x00, 0x42, 0x7f, 0x40, 0x00 }, /* 1 */
+  { 0x42, 0x61, 0x51, 0x49, 0x46 }, /* 2 */
+  { 0x21, 0x41, 0x45, 0x4b, 0x31 }, /* 3 */
+  { 0x18, 0x14, 0x12, 0x7f, 0x10 }, /* 4 */
+  { 0x27, 0x45, 0x45, 0x45, 0x39 }, /* 5 */
+  { 0x3c, 0x4a, 0x49, 0x49, 0x30 }, /* 6 */
+  { 0x01, 0x71, 0x09, 0x05, 0x03 }, /* 7 */
+  { 0x36, 0x49, 0x49, 0x49, 0x36 }, /* 8 */
+  { 0x06, 0x49, 0x49, 0x29, 0x1e }, /* 9 */
+  { 0x00, 0x00, 0x00, 0x00, 0x00 }, /* space */
+  { 0x08, 0x08, 0x3e, 0x08, 0x08 }, /* + */
+  { 0x08, 0x08, 0x08, 0x08, 0x08 }, /* - */
+  { 0x00, 0x60, 0x60, 0x00, 0x00 }, /* . */
+  { 0x38, 0x44, 0x44, 0x48, 0x7f }, /* d */
+  { 0x7f, 0x49, 0x49, 0x49, 0x36 }  /* B */
+};
+
+#define TEXT_SPRITE_SPACE (10)
+
+
+static uint8_t
+text_sprite_glyph(char c)
+{
+  if (c >= '0' && c <= '9') {
+    return c - '0';
+  }
+
+  for (uint8_t i = 0; i < sizeof(TEXT_SPRITE_SYMBOLS) - 1; ++i) {
+    if (pgm_read_byte(TEXT_SPRITE_SYMBOLS + i) == c) {
+      return TEXT_SPRITE_SPACE + i;
+    }
+  }
+
+  assert(false);
+  return TEXT_SPRITE_SPACE;
+}
+
+
+/* Single page tall at given page, showing `length` characters. Nothing is
+ * changed yet, it's all sent with the first full update. */
+void
+text_sprite_init(text_sprite_t *text, uint8_t column, uint8_t page, uint8_t length,
+                 const char *chars)
+{
+  assert(length > 0 && length <= TEXT_SPRITE_MAX_LENGTH);
+
+  sprite_init(&(text->sprite), &text_sprite_render);
+  text->sprite.opaque = true;
+  text->length = length;
+
+  for (uint8_t i = 0; i < length; ++i) {
+    text->glyphs[i] = text_sprite_glyph(chars[i]);
+  }
+
+  text->changed_cells = 0;
+
+  /* Blank column after the last glyph isn't part of the sprite */
+  sprite_set_bounds(&(text->sprite), page, page, column,
+                    column + length * TEXT_SPRITE_CELL_WIDTH - 2);
+}
+
+
+/* Takes exactly `length` characters, cells showing the same glyph as before
+ * are left as they are. Previous update has to be sent already. */
+void
+text_sprite_set_text(text_sprite_t *text, const char *chars)
+{
+  for (uint8_t i = 0; i < text->length; ++i) {
+    uint8_t glyph = text_sprite_glyph(chars[i]);
+
+    if (text->glyphs[i] != glyph) {
+      text->glyphs[i] = glyph;
+      text->changed_cells |= 1 << i;
+    }
+  }
+}
+
+
+bool
+text_sprite_is_changed(text_sprite_t *text)
+{
+  return text->changed_cells != 0;
+}
+
+
+/* Adds glyph columns of each changed cell, and forgets the changes */
+void
+text_sprite_add_to_extents(text_sprite_t *text, update_extents_t *extents)
+{
+  uint8_t column = text->sprite.start_column;
+
+  for (uint8_t i = 0; i < text->length; ++i) {
+    if (text->changed_cells & (1 << i)) {
+      update_extents_add_region(extents, text->sprite.start_page, column,
+                                column + TEXT_SPRITE_GLYPH_WIDTH - 1);
+    }
+
+    column += TEXT_SPRITE_CELL_WIDTH;
+  }
+
+  text->changed_cells = 0;
+}
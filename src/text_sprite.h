@@ -0,0 +1,69 @@
+#ifndef TEXT_SPRITE_H
+#define TEXT_SPRITE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <avr/pgmspace.h>
+#include "ssd1306.h"
+#include "display.h"
+#include "utils.h"
+
+/* Glyphs are a single page tall, cells are separated by a blank column */
+#define TEXT_SPRITE_GLYPH_WIDTH (5)
+#define TEXT_SPRITE_CELL_WIDTH (TEXT_SPRITE_GLYPH_WIDTH + 1)
+#define TEXT_SPRITE_MAX_LENGTH (8)
+
+
+/* Digits first, then symbols in order of TEXT_SPRITE_SYMBOLS, see text_sprite.c */
+extern const uint8_t TEXT_SPRITE_FONT[][TEXT_SPRITE_GLYPH_WIDTH] PROGMEM;
+
+
+/* Line of characters, each in a cell of its own. Cells changed since they
+ * were last added to extents are tracked, so only those are sent again. */
+typedef struct text_sprite_t_ {
+  sprite_t sprite;
+  uint8_t length;
+  uint8_t glyphs[TEXT_SPRITE_MAX_LENGTH]; /* indices into TEXT_SPRITE_FONT */
+  uint8_t changed_cells; /* bit for each cell */
+} text_sprite_t;
+
+
+/* Cells are opaque, glyphs and the blank column after each one replace
+ * whatever is below, so the text stays readable over other sprites */
+inline void
+text_sprite_render(sprite_t *sprite, uint8_t column_a, uint8_t page, uint8_t column_b, ssd1306_segment_t* segments)
+{
+  text_sprite_t *text = (text_sprite_t *) sprite;
+
+  uint8_t target_column_a = int_max(column_a, text->sprite.start_column);
+  uint8_t target_column_b = int_min(column_b, text->sprite.end_column);
+  uint8_t offset = target_column_a - text->sprite.start_column;
+  uint8_t cell = offset / TEXT_SPRITE_CELL_WIDTH;
+  uint8_t x = offset % TEXT_SPRITE_CELL_WIDTH;
+
+  ssd1306_segment_t *target = segments + target_column_a - column_a;
+
+  for (uint8_t i = target_column_a; i <= target_column_b; ++i) {
+    if (x < TEXT_SPRITE_GLYPH_WIDTH) {
+      *target = pgm_read_byte(&(TEXT_SPRITE_FONT[text->glyphs[cell]][x]));
+      ++x;
+    }
+    else {
+      *target = 0;
+      x = 0;
+      ++cell;
+    }
+
+    ++target;
+  }
+}
+
+
+void text_sprite_init(text_sprite_t *text, uint8_t column, uint8_t page, uint8_t length,
+                      const char *chars);
+void text_sprite_set_text(text_sprite_t *text, const char *chars);
+bool text_sprite_is_changed(text_sprite_t *text);
+void text_sprite_add_to_extents(text_sprite_t *text, update_extents_t *extents);
+
+
+#endif /* TEXT_SPRITE_H */
@@ -0,0 +1,22 @@
+#include "transfer_curve.h"
+#include <stdint.h>
+#include <avr/pgmspace.h>
+
+const uint8_t TRANSFER_CURVE[TRANSFER_CURVE_N] PROGMEM = {
+    0,   2,   3,   5,   6,   8,   9,  11,  12,  14,  16,  17,  19,  20,  22,  23,
+   25,  26,  28,  30,  31,  33,  34,  36,  37,  39,  40,  42,  44,  45,  47,  48,
+   50,  51,  53,  54,  56,  58,  59,  61,  62,  64,  65,  67,  68,  70,  72,  73,
+   75,  76,  78,  79,  81,  82,  84,  86,  87,  89,  90,  92,  93,  95,  96,  98,
+  100, 101, 103, 104, 106, 107, 109, 110, 112, 114, 115, 117, 118, 120, 121, 123,
+  124, 126, 128, 129, 131, 132, 134, 135, 137, 138, 140, 141, 143, 145, 146, 148,
+  149, 151, 152, 154, 155, 157, 159, 160, 162, 163, 165, 166, 168, 169, 171, 173,
+  174, 176, 177, 179, 180, 182, 183, 185, 187, 188, 190, 191, 193, 194, 196, 197,
+  199, 201, 202, 204, 205, 207, 208, 210, 211, 213, 215, 216, 218, 219, 221, 222,
+  224, 225, 227, 229, 230, 232, 233, 235, 236, 238, 239, 241, 243, 244, 246, 247,
+  249, 250, 252, 253, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+  255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+  255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+  255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+  255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+  255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+};
@@ -0,0 +1,28 @@
+#ifndef TRANSFER_CURVE_H
+#define TRANSFER_CURVE_H
+
+#include <stdint.h>
+#include <avr/pgmspace.h>
+#include "config.h"
+
+
+/* Covers rectified input up to 511 ADC codes, past the full scale */
+#define TRANSFER_CURVE_N (512 >> TRANSFER_CURVE_SHIFT)
+
+extern const uint8_t TRANSFER_CURVE[TRANSFER_CURVE_N];
+
+
+static inline uint8_t
+transfer_curve_get_angle(uint16_t magnitude)
+{
+  uint16_t index = magnitude >> TRANSFER_CURVE_SHIFT;
+
+  if (index >= TRANSFER_CURVE_N) {
+    index = TRANSFER_CURVE_N - 1;
+  }
+
+  return pgm_read_byte(TRANSFER_CURVE + index);
+}
+
+
+#endif /* TRANSFER_CURVE_H */
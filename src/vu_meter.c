@@ -0,0 +1,265 @@
+#include "vu_meter.h"
+#include <avr/pgmspace.h>
+#include "config.h"
+#include "utils.h"
+#include "assert.h"
+#include "probe.h"
+#include "images.h"
+#include "progmem_image_sprite.h"
+#include "progmem_rle_image_sprite.h"
+#include "text_sprite.h"
+
+
+#if DISPLAY_STATIC_LAYERS
+DISPLAY_DEFINE_LAYERS
+#endif
+
+
+/* Each meter has its own, bottom right */
+#define VU_METER_PEAK_COLUMN (107)
+#define VU_METER_PEAK_PAGE (7)
+
+
+#if VU_METER_READOUT
+/* Bottom left, blank on the background. Needle reaches columns 26..101 of
+ * the last page, so it passes behind the last cell near rest position. */
+#define VU_METER_READOUT_COLUMN (0)
+#define VU_METER_READOUT_PAGE (7)
+#define VU_METER_READOUT_LENGTH (5)
+#define VU_METER_READOUT_MIN_DB (-20)
+#define VU_METER_READOUT_BELOW_MIN_DB (VU_METER_READOUT_MIN_DB - 1)
+
+/* Lowest angle rounded to each dB from VU_METER_READOUT_MIN_DB to +3VU at
+ * full scale, 255 * 10^((dB - 3.5) / 20), as the scale in images/scale. */
+static const uint8_t VU_METER_DB_ANGLES[] PROGMEM = {
+   18,  20,  22,  25,  28,  31,  35,  39,  43,  49,  54,  61,
+   68,  77,  86,  96, 108, 121, 136, 152, 171, 192, 215, 241
+};
+#endif
+
+
+void
+vu_meter_init(vu_meter_t *meter, int8_t address, uint8_t channel, sprite_t *background)
+{
+  ssd1306_init(&(meter->device), address, channel);
+  display_init(&(meter->display), &(meter->device));
+
+  display_add_sprite(&(meter->display), background);
+
+  /* Off until the first peak */
+  progmem_image_sprite_init(&(meter->peak_indicator), PEAK_INDICATOR, VU_METER_PEAK_COLUMN,
+                            VU_METER_PEAK_PAGE);
+  display_add_sprite(&(meter->display), &(meter->peak_indicator.sprite));
+  meter->peak_indicator.sprite.visible = false;
+
+  needle_sprite_init(&(meter->needle));
+  needle_sprite_draw(&(meter->needle), 0);
+  display_add_sprite(&(meter->display), &(meter->needle).sprite);
+
+#if VU_METER_READOUT
+  text_sprite_init(&(meter->readout), VU_METER_READOUT_COLUMN, VU_METER_READOUT_PAGE,
+                   VU_METER_READOUT_LENGTH, "---dB");
+  meter->readout_db = VU_METER_READOUT_BELOW_MIN_DB;
+  display_add_sprite(&(meter->display), &(meter->readout.sprite));
+#endif
+}
+
+
+typedef struct vu_meter_config_t_ {
+  uint8_t address;
+  uint8_t channel;
+} vu_meter_config_t;
+
+#define VU_METER_CONFIG(address, channel, source) { address, channel },
+
+static const vu_meter_config_t VU_METER_CONFIGS[VU_METERS_N] = { VU_METERS(VU_METER_CONFIG) };
+
+
+/* Initializes all VU_METERS, sorted by mux channel, so that meters on the
+ * same channel are next to each other, in order of config otherwise. Index of
+ * each meter in VU_METERS is stored into `config_indices`.
+ */
+void
+vu_meter_init_all(vu_meter_t *meters, uint8_t *config_indices, sprite_t *background)
+{
+  uint8_t meters_n = 0;
+
+  for (uint8_t channel = 0; channel < 8; ++channel) {
+    for (uint8_t i = 0; i < VU_METERS_N; ++i) {
+      const vu_meter_config_t *config = &(VU_METER_CONFIGS[i]);
+
+      if (config->channel == channel) {
+        vu_meter_init(&(meters[meters_n]), config->address, channel, background);
+        config_indices[meters_n] = i;
+        ++meters_n;
+      }
+    }
+  }
+
+  assert(meters_n == VU_METERS_N);
+}
+
+
+/* All meters look the same right after init, so their first full update is
+ * rendered only once for each run of meters on the same mux channel, and sent
+ * to each of them. Their init sequences go in the same transaction, and
+ * nothing waits for any of it.
+ */
+void
+vu_meter_redraw_all(vu_meter_t *meters, uint8_t meters_n)
+{
+  /* Each run takes its own part, they're all queued at once */
+  static display_t *others[VU_METERS_N];
+
+  assert(meters_n <= VU_METERS_N);
+
+  for (uint8_t i = 0; i < meters_n; ++i) {
+    others[i] = &(meters[i].display);
+  }
+
+  uint8_t first = 0;
+
+  for (uint8_t i = 1; i <= meters_n; ++i) {
+    if (i == meters_n || meters[i].device.channel != meters[first].device.channel) {
+      display_update_multicast_async(&(meters[first].display), &(others[first + 1]), i - first - 1);
+      first = i;
+    }
+  }
+}
+
+
+void
+vu_meter_show_peak(vu_meter_t *meter, bool peak)
+{
+  sprite_t *sprite = &(meter->peak_indicator.sprite);
+
+  if (sprite->visible != peak) {
+    sprite->visible = peak;
+    display_invalidate_sprite(&(meter->display), sprite);
+  }
+}
+
+
+/* Needle moves by single position only if the angle gets past the boundary by
+ * NEEDLE_HYSTERESIS, so noise around the boundary doesn't make it jitter.
+ */
+static uint8_t
+needle_index_with_hysteresis(uint8_t index, uint8_t angle)
+{
+  uint8_t index_low = needle_angle_to_index(int_max((int16_t) angle - NEEDLE_HYSTERESIS, 0));
+  uint8_t index_high = needle_angle_to_index(int_min((int16_t) angle + NEEDLE_HYSTERESIS, 255));
+
+  if (index >= index_low && index <= index_high) {
+    return index;
+  }
+
+  return needle_angle_to_index(angle);
+}
+
+
+#if VU_METER_READOUT
+static int8_t
+angle_to_db(uint8_t angle)
+{
+  int8_t db = VU_METER_READOUT_BELOW_MIN_DB;
+
+  for (uint8_t i = 0; i < sizeof(VU_METER_DB_ANGLES); ++i) {
+    if (angle >= pgm_read_byte(VU_METER_DB_ANGLES + i)) {
+      db = VU_METER_READOUT_MIN_DB + i;
+    }
+  }
+
+  return db;
+}
+
+
+/* Same as for the needle, so the readout doesn't flicker between two values */
+static int8_t
+db_with_hysteresis(int8_t db, uint8_t angle)
+{
+  int8_t db_low = angle_to_db(int_max((int16_t) angle - NEEDLE_HYSTERESIS, 0));
+  int8_t db_high = angle_to_db(int_min((int16_t) angle + NEEDLE_HYSTERESIS, 255));
+
+  if (db >= db_low && db <= db_high) {
+    return db;
+  }
+
+  return angle_to_db(angle);
+}
+
+
+/* Right aligned with its sign, e.g. "-20dB", " -3dB", "  0dB" or "---dB" */
+static void
+vu_meter_show_db(vu_meter_t *meter, int8_t db)
+{
+  char chars[VU_METER_READOUT_LENGTH] = { '-', '-', '-', 'd', 'B' };
+
+  if (db != VU_METER_READOUT_BELOW_MIN_DB) {
+    uint8_t magnitude = (db < 0) ? -db : db;
+    char sign = (db > 0) ? '+' : ((db < 0) ? '-' : ' ');
+
+    chars[0] = (magnitude >= 10) ? sign : ' ';
+    chars[1] = (magnitude >= 10) ? '0' + magnitude / 10 : sign;
+    chars[2] = '0' + magnitude % 10;
+  }
+
+  text_sprite_set_text(&(meter->readout), chars);
+  meter->readout_db = db;
+}
+#endif
+
+
+/* Skips the update if neither needle, readout nor any sprite changed */
+bool
+vu_meter_update(vu_meter_t *meter, uint8_t angle)
+{
+  uint8_t index = needle_sprite_get_index(&(meter->needle));
+  uint8_t new_index = needle_index_with_hysteresis(index, angle);
+
+#if VU_METER_READOUT
+  int8_t db = db_with_hysteresis(meter->readout_db, angle);
+  bool readout_changed = (db != meter->readout_db);
+#else
+  bool readout_changed = false;
+#endif
+
+  if (new_index == index && !readout_changed && !display_is_invalidated(&(meter->display))) {
+    return false;
+  }
+
+  /* Needle and extents are still in use until previous update is sent */
+  display_wait(&(meter->display));
+
+  bool needle_moved = (new_index != index);
+
+  update_extents_reset(&(meter->update_extents));
+
+  if (needle_moved) {
+    needle_sprite_add_to_extents(&(meter->needle), &(meter->update_extents));
+    PROBE(NEEDLE_DRAW, needle_sprite_draw_index(&(meter->needle), new_index));
+  }
+
+  PROBE_BEGIN(EXTENTS);
+
+  /* Both old and new position of the needle are redrawn */
+  if (needle_moved) {
+    needle_sprite_add_to_extents(&(meter->needle), &(meter->update_extents));
+  }
+
+#if VU_METER_READOUT
+  /* Only characters that changed are sent */
+  if (readout_changed) {
+    vu_meter_show_db(meter, db);
+    text_sprite_add_to_extents(&(meter->readout), &(meter->update_extents));
+  }
+#endif
+
+  display_add_invalidated_to_extents(&(meter->display), &(meter->update_extents));
+
+  update_extents_combine_pages(&(meter->update_extents));
+
+  PROBE_END(EXTENTS);
+
+  display_update_partial_async(&(meter->display), &(meter->update_extents));
+  return true;
+}
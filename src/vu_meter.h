@@ -0,0 +1,34 @@
+#ifndef VU_METER_H
+#define VU_METER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "config.h"
+#include "ssd1306.h"
+#include "display.h"
+#include "needle_sprite.h"
+#include "progmem_image_sprite.h"
+#include "text_sprite.h"
+
+
+typedef struct vu_meter_t_ {
+  ssd1306_t device;
+  display_t display;
+  needle_sprite_t needle;
+  progmem_image_sprite_t peak_indicator;
+  update_extents_t update_extents;
+#if VU_METER_READOUT
+  text_sprite_t readout;
+  int8_t readout_db;
+#endif
+} vu_meter_t;
+
+
+void vu_meter_init(vu_meter_t *meter, int8_t address, uint8_t channel, sprite_t *background);
+void vu_meter_init_all(vu_meter_t *meters, uint8_t *config_indices, sprite_t *background);
+void vu_meter_redraw_all(vu_meter_t *meters, uint8_t meters_n);
+void vu_meter_show_peak(vu_meter_t *meter, bool peak);
+bool vu_meter_update(vu_meter_t *meter, uint8_t angle);
+
+
+#endif /* VU_METER_H */